@@ -106,6 +106,12 @@ public:
     bool bptree_traverse(TraverseFunc) override;
     void verify() const override;
 
+    // Destroy the leading children holding only elements before `n`, and
+    // recurse into the first remaining child if it is an inner node. At least
+    // one child is kept. Returns the number of elements removed, which is
+    // less than `n` when `n` falls inside a leaf.
+    size_t bptree_erase_front(size_t n);
+
     // Other modifiers
 
     void append_tree_size(size_t sz)
@@ -477,6 +483,50 @@ size_t BPlusTreeInner::bptree_erase(size_t n, EraseFunc func)
     return num_children;
 }
 
+size_t BPlusTreeInner::bptree_erase_front(size_t n)
+{
+    ensure_offsets();
+
+    size_t num_children = get_node_size();
+    size_t num_dropped = 0;
+    while (num_dropped < num_children - 1 && m_offsets.get(num_dropped) <= n)
+        ++num_dropped;
+
+    size_t num_erased = get_bp_node_offset(num_dropped);
+    if (num_dropped > 0) {
+        std::vector<ref_type> dropped_refs;
+        dropped_refs.reserve(num_dropped);
+        for (size_t i = 0; i < num_dropped; ++i)
+            dropped_refs.push_back(get_bp_node_ref(i));
+        Array::erase(1, 1 + num_dropped); // Throws
+        size_t num_offsets = m_offsets.size();
+        for (size_t i = num_dropped; i < num_offsets; ++i)
+            m_offsets.set(i - num_dropped, m_offsets.get(i) - num_erased); // Throws
+        m_offsets.truncate(num_offsets - num_dropped);
+        set_tree_size(get_tree_size() - num_erased);
+        for (ref_type ref : dropped_refs)
+            Array::destroy_deep(ref, m_alloc);
+    }
+
+    if (num_erased < n) {
+        ref_type child_ref = get_bp_node_ref(0);
+        char* child_header = m_alloc.translate(child_ref);
+        if (Array::get_is_inner_bptree_node_from_header(child_header)) {
+            BPlusTreeInner node(m_tree);
+            node.set_parent(this, 1);
+            node.init_from_mem(MemRef(child_header, child_ref, m_alloc));
+            size_t num_erased_in_child = node.bptree_erase_front(n - num_erased); // Throws
+            if (num_erased_in_child > 0) {
+                m_offsets.adjust(0, m_offsets.size(), -int64_t(num_erased_in_child));
+                set_tree_size(get_tree_size() - num_erased_in_child);
+                num_erased += num_erased_in_child;
+            }
+        }
+    }
+
+    return num_erased;
+}
+
 bool BPlusTreeInner::bptree_traverse(TraverseFunc func)
 {
     size_t sz = get_node_size();
@@ -797,6 +847,33 @@ void BPlusTreeBase::bptree_insert(size_t n, BPlusTreeNode::InsertFunc func)
 void BPlusTreeBase::bptree_erase(size_t n, BPlusTreeNode::EraseFunc func)
 {
     size_t root_size = m_root->bptree_erase(n, func);
+    reduce_root(root_size);
+}
+
+void BPlusTreeBase::erase_front(size_t n)
+{
+    REALM_ASSERT_3(n, <=, m_size);
+    if (n == m_size) {
+        clear();
+        return;
+    }
+
+    if (!m_root->is_leaf()) {
+        BPlusTreeInner* root = static_cast<BPlusTreeInner*>(m_root.get());
+        size_t num_erased = root->bptree_erase_front(n); // Throws
+        invalidate_leaf_cache();
+        m_size -= num_erased;
+        n -= num_erased;
+        reduce_root(m_root->get_node_size());
+    }
+
+    // The remaining elements are all in the first leaf
+    while (n > 0)
+        erase(--n); // Throws
+}
+
+void BPlusTreeBase::reduce_root(size_t root_size)
+{
     while (!m_root->is_leaf() && root_size == 1) {
         BPlusTreeInner* node = static_cast<BPlusTreeInner*>(m_root.get());
         ref_type orig_root_ref = node->get_ref();
@@ -209,6 +209,11 @@ public:
     virtual void clear() = 0;
     virtual void swap(size_t, size_t) = 0;
 
+    // Erase the first `n` elements. Leading nodes holding only erased elements
+    // are destroyed without being visited element by element, so the cost is
+    // proportional to `n` rather than to the size of the tree.
+    void erase_front(size_t n);
+
     void create();
     void destroy();
     void verify() const
@@ -252,6 +257,7 @@ protected:
 
     void bptree_insert(size_t n, BPlusTreeNode::InsertFunc func);
     void bptree_erase(size_t n, BPlusTreeNode::EraseFunc func);
+    void reduce_root(size_t root_size);
 
     // Create an un-attached leaf node
     virtual std::unique_ptr<BPlusTreeLeaf> create_leaf_node() = 0;
@@ -36,6 +36,7 @@
 
 #include <s2/s2cap.h>
 #include <s2/s2latlng.h>
+#include <s2/s2latlngrect.h>
 #include <s2/s2polygon.h>
 
 #ifdef _WIN32
@@ -536,6 +537,13 @@ GeoRegion::GeoRegion(const Geospatial& geo)
     };
 
     m_region = mpark::visit(Visitor(m_status), geo.m_value);
+    if (m_status.is_ok() && m_region) {
+        // The bound is computed from the region's vertices after conversion to points on
+        // the sphere. Widen it slightly so that points on the border, which may round
+        // differently when taken directly from degrees, still reach the exact test.
+        auto margin = S2LatLng::FromDegrees(1e-7, 1e-7);
+        m_bound = std::make_unique<S2LatLngRect>(m_region->GetRectBound().Expanded(margin));
+    }
 }
 
 GeoRegion::~GeoRegion() = default;
@@ -549,6 +557,12 @@ bool GeoRegion::contains(const std::optional<GeoPoint>& geo_point) const noexcep
     if (!point.is_valid()) {
         return false;
     }
+    // The bound is conservative, so this only prunes points that cannot be inside the
+    // region. It is a few interval comparisons, whereas the exact test below needs
+    // trigonometry to convert the point and, for polygons, an edge crossing search.
+    if (m_bound && !m_bound->Contains(point)) {
+        return false;
+    }
     return m_region->VirtualContainsPoint(point.ToPoint());
 }
 
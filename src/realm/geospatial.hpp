@@ -31,6 +31,7 @@
 #include <vector>
 
 class S2Region;
+class S2LatLngRect;
 
 namespace realm {
 
@@ -141,6 +142,9 @@ public:
 
 private:
     std::unique_ptr<S2Region> m_region;
+    // Bounding rectangle of m_region in lat/lng space. Points outside of it are
+    // rejected without converting them to points on the sphere.
+    std::unique_ptr<S2LatLngRect> m_bound;
     Status m_status;
 };
 
@@ -1351,7 +1351,7 @@ void StringIndex::erase(ObjKey key)
         if (m_target_column.tokenize()) {
             // This is a full text index
             auto index_data(get(key).get_index_data(buffer));
-            auto words = Tokenizer::get_instance()->reset(std::string_view(index_data)).get_all_tokens();
+            auto words = Tokenizer::get_thread_instance().reset(std::string_view(index_data)).get_all_tokens();
             for (auto& w : words) {
                 erase_string(key, w);
             }
@@ -1482,9 +1482,9 @@ void StringIndex::find_all_fulltext(std::vector<ObjKey>& result, StringData valu
     InternalFindResult res;
     REALM_ASSERT(result.empty());
 
-    auto tokenizer = Tokenizer::get_instance();
-    tokenizer->reset({value.data(), value.size()});
-    auto [includes, excludes] = tokenizer->get_search_tokens();
+    auto& tokenizer = Tokenizer::get_thread_instance();
+    tokenizer.reset({value.data(), value.size()});
+    auto [includes, excludes] = tokenizer.get_search_tokens();
     if (includes.empty()) {
         if (excludes.empty()) {
             throw InvalidArgument("Missing search token");
@@ -1781,7 +1781,8 @@ void StringIndex::insert(ObjKey key, const Mixed& value)
 
     if (this->m_target_column.tokenize()) {
         if (value.is_type(type_String)) {
-            auto words = Tokenizer::get_instance()->reset(std::string_view(value.get<StringData>())).get_all_tokens();
+            auto& tokenizer = Tokenizer::get_thread_instance();
+            auto words = tokenizer.reset(std::string_view(value.get<StringData>())).get_all_tokens();
 
             for (auto& word : words) {
                 Mixed m(word);
@@ -1800,17 +1801,17 @@ void StringIndex::set(ObjKey key, const Mixed& new_value)
     Mixed old_value = get(key);
 
     if (this->m_target_column.tokenize()) {
-        auto tokenizer = Tokenizer::get_instance();
+        auto& tokenizer = Tokenizer::get_thread_instance();
         StringData old_string = old_value.get_index_data(buffer);
         std::set<std::string> old_words;
 
         if (old_string.size() > 0) {
-            tokenizer->reset({old_string.data(), old_string.size()});
-            old_words = tokenizer->get_all_tokens();
+            tokenizer.reset({old_string.data(), old_string.size()});
+            old_words = tokenizer.get_all_tokens();
         }
         std::set<std::string> new_words;
         if (new_value.is_type(type_String)) {
-            new_words = tokenizer->reset(std::string_view(new_value.get<StringData>())).get_all_tokens();
+            new_words = tokenizer.reset(std::string_view(new_value.get<StringData>())).get_all_tokens();
         }
 
         auto w1 = old_words.begin();
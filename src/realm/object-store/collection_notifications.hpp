@@ -108,6 +108,11 @@ struct CollectionChangeSet {
 
     std::set<StableIndex> paths;
 
+    // Set if the changes made by a write were left out because its notification
+    // was suppressed with NotificationToken::suppress_next(). The change set then
+    // does not cover everything which changed since the previous notification.
+    bool changes_skipped = false;
+
     bool empty() const noexcept
     {
         return deletions.empty() && insertions.empty() && modifications.empty() && modifications_new.empty() &&
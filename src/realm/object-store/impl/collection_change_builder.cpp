@@ -19,6 +19,7 @@
 #include <realm/object-store/impl/collection_change_builder.hpp>
 
 #include <realm/util/assert.hpp>
+#include <realm/util/scope_exit.hpp>
 
 #include <algorithm>
 
@@ -44,6 +45,10 @@ CollectionChangeBuilder::CollectionChangeBuilder(IndexSet deletions, IndexSet in
 
 void CollectionChangeBuilder::merge(CollectionChangeBuilder&& c)
 {
+    // A skipped write is remembered even when either side has no other changes
+    auto merge_skipped = util::make_scope_exit([&, skipped = changes_skipped || c.changes_skipped]() noexcept {
+        changes_skipped = skipped;
+    });
     if (c.empty())
         return;
     if (empty()) {
@@ -383,8 +388,10 @@ public:
     std::vector<Match> m_longest_matches;
 
     LongestCommonSubsequenceCalculator(std::vector<Row>& a, std::vector<Row>& b, size_t start_index,
-                                       IndexSet const& modifications)
+                                       IndexSet const& modifications, size_t modifications_offset)
         : m_modified(modifications)
+        , m_modified_offset(modifications_offset)
+        , m_budget(std::max<size_t>((a.size() - start_index) * max_work_per_row, min_work))
         , a(a)
         , b(b)
     {
@@ -392,8 +399,27 @@ public:
         m_longest_matches.push_back({a.size(), b.size(), 0});
     }
 
+    // True if the matches were abandoned because finding them was taking too
+    // long, in which case m_longest_matches is incomplete
+    bool exceeded_budget() const noexcept
+    {
+        return m_exceeded_budget;
+    }
+
 private:
+    // Each level of recursion scans every row in the ranges being searched,
+    // so the work done is roughly the number of rows times the number of
+    // levels, which grows with the number of moved rows. When lots of rows
+    // have moved, reporting them all as removed and reinserted is both far
+    // cheaper and about as useful as an exact set of moves.
+    static constexpr size_t max_work_per_row = 32;
+    static constexpr size_t min_work = 4096;
+
     IndexSet const& m_modified;
+    // The index in the full collection of the first row of `b`
+    size_t m_modified_offset;
+    size_t m_budget;
+    bool m_exceeded_budget = false;
 
     // The two arrays of rows being diffed
     // a is sorted by tv_index, b is sorted by key
@@ -450,6 +476,12 @@ private:
         };
 
         Match best = {begin1, begin2, 0, 0};
+        if (end1 - begin1 > m_budget) {
+            m_exceeded_budget = true;
+            return best;
+        }
+        m_budget -= end1 - begin1;
+
         for (size_t i = begin1; i < end1; ++i) {
             // prev = std::move(cur), but avoids discarding prev's heap allocation
             cur.swap(prev);
@@ -467,8 +499,9 @@ private:
                 // Given two equal-length matches, prefer the one with fewer modified rows
                 else if (size == best.size) {
                     if (best.modified == IndexSet::npos)
-                        best.modified = m_modified.count(best.j - size + 1, best.j + 1);
-                    auto count = m_modified.count(j - size + 1, j + 1);
+                        best.modified = m_modified.count(m_modified_offset + best.j - size + 1,
+                                                         m_modified_offset + best.j + 1);
+                    auto count = m_modified.count(m_modified_offset + j - size + 1, m_modified_offset + j + 1);
                     if (count < best.modified)
                         best = {i - size + 1, j - size + 1, size, count};
                 }
@@ -489,17 +522,19 @@ private:
         // biasing equal selections towards the middle, but that's still
         // insufficient for Android's 8 KB stacks
         auto m = find_longest_match(begin1, end1, begin2, end2);
-        if (!m.size)
+        if (!m.size || m_exceeded_budget)
             return;
         if (m.i > begin1 && m.j > begin2)
             find_longest_matches(begin1, m.i, begin2, m.j);
+        if (m_exceeded_budget)
+            return;
         m_longest_matches.push_back(m);
         if (m.i + m.size < end2 && m.j + m.size < end2)
             find_longest_matches(m.i + m.size, end1, m.j + m.size, end2);
     }
 };
 
-void calculate_moves_sorted(std::vector<RowInfo>& rows, CollectionChangeSet& changeset)
+void calculate_moves_sorted(std::vector<RowInfo>& rows, CollectionChangeSet& changeset, size_t offset)
 {
     // The RowInfo array contains information about the old and new TV indices of
     // each row, which we need to turn into two sequences of rows, which we'll
@@ -534,12 +569,20 @@ void calculate_moves_sorted(std::vector<RowInfo>& rows, CollectionChangeSet& cha
     });
 
     // Calculate the LCS of the two sequences
-    auto matches =
-        LongestCommonSubsequenceCalculator(a, b, first_difference, changeset.modifications).m_longest_matches;
+    LongestCommonSubsequenceCalculator lcs(a, b, first_difference, changeset.modifications, offset);
+    if (lcs.exceeded_budget()) {
+        // Report everything from the first difference on as removed and
+        // reinserted rather than the individual moves
+        for (size_t i = first_difference; i < a.size(); ++i) {
+            changeset.deletions.add(a[i].tv_index);
+            changeset.insertions.add(rows[i].tv_index);
+        }
+        return;
+    }
 
     // And then insert and delete rows as needed to align them
     size_t i = first_difference, j = first_difference;
-    for (auto match : matches) {
+    for (auto match : lcs.m_longest_matches) {
         for (; i < match.i; ++i)
             changeset.deletions.add(a[i].tv_index);
         for (; j < match.j; ++j)
@@ -576,7 +619,7 @@ void verify_changeset(std::vector<T> const& prev_rows, std::vector<T> const& nex
 }
 
 void calculate(CollectionChangeBuilder& ret, std::vector<RowInfo> old_rows, std::vector<RowInfo> new_rows,
-               util::FunctionRef<bool(int64_t)> key_did_change, bool in_table_order)
+               util::FunctionRef<bool(int64_t)> key_did_change, bool in_table_order, size_t offset)
 {
     // Now that our old and new sets of rows are sorted by key, we can
     // iterate over them and either record old+new TV indices for rows present
@@ -612,9 +655,11 @@ void calculate(CollectionChangeBuilder& ret, std::vector<RowInfo> old_rows, std:
                                       return row.prev_tv_index == IndexSet::npos;
                                   }),
                    end(new_rows));
-    std::sort(begin(new_rows), end(new_rows), [](auto& lft, auto& rgt) {
+    auto by_tv_index = [](auto& lft, auto& rgt) {
         return lft.tv_index < rgt.tv_index;
-    });
+    };
+    if (!std::is_sorted(begin(new_rows), end(new_rows), by_tv_index))
+        std::sort(begin(new_rows), end(new_rows), by_tv_index);
 
     for (auto& row : new_rows) {
         if (key_did_change(row.key)) {
@@ -623,7 +668,7 @@ void calculate(CollectionChangeBuilder& ret, std::vector<RowInfo> old_rows, std:
     }
 
     if (!in_table_order)
-        calculate_moves_sorted(new_rows, ret);
+        calculate_moves_sorted(new_rows, ret, offset);
 }
 
 template <typename T>
@@ -640,22 +685,78 @@ int64_t to_int64_t<ObjKey>(ObjKey val)
 
 void sort_row_info(std::vector<RowInfo>& info)
 {
-    std::sort(begin(info), end(info), [](auto& lft, auto& rgt) {
+    auto by_key = [](auto& lft, auto& rgt) {
         return lft.key < rgt.key;
-    });
+    };
+    // Results in table order are already sorted by key
+    if (!std::is_sorted(begin(info), end(info), by_key))
+        std::sort(begin(info), end(info), by_key);
 }
 
 template <typename T>
-std::vector<RowInfo> build_row_info(const std::vector<T>& rows)
+std::vector<RowInfo> build_row_info(const std::vector<T>& rows, size_t begin, size_t end)
 {
     std::vector<RowInfo> info;
-    info.reserve(rows.size());
-    for (size_t i = 0; i < rows.size(); ++i)
+    info.reserve(end - begin);
+    for (size_t i = begin; i < end; ++i)
         info.push_back({to_int64_t(rows[i]), IndexSet::npos, i});
     sort_row_info(info);
     return info;
 }
 
+// Only the rows between the longest common prefix and suffix of the two
+// collections need to be diffed, as the rows in the prefix and suffix keep
+// their position and can at most have been modified. This makes appending,
+// and changes near the start or end of large collections, linear time.
+template <typename T>
+void calculate_trimmed(CollectionChangeBuilder& ret, const std::vector<T>& prev_rows,
+                       const std::vector<T>& next_rows, util::FunctionRef<bool(int64_t)> key_did_change,
+                       bool in_table_order)
+{
+    size_t common = std::min(prev_rows.size(), next_rows.size());
+    size_t prefix = 0;
+    while (prefix < common && prev_rows[prefix] == next_rows[prefix])
+        ++prefix;
+    size_t suffix = 0;
+    while (prefix + suffix < common &&
+           prev_rows[prev_rows.size() - suffix - 1] == next_rows[next_rows.size() - suffix - 1])
+        ++suffix;
+
+    auto old_info = build_row_info(prev_rows, prefix, prev_rows.size() - suffix);
+    auto new_info = build_row_info(next_rows, prefix, next_rows.size() - suffix);
+
+    // Lists can contain duplicates, and a row which also appears in the middle
+    // may need to be matched up with a different copy than the one at the same
+    // position, so fall back to diffing everything
+    auto in_middle = [&](const T& row) {
+        auto key = to_int64_t(row);
+        auto contains = [key](const std::vector<RowInfo>& info) {
+            auto it = std::lower_bound(info.begin(), info.end(), key, [](auto& lft, int64_t rgt) {
+                return lft.key < rgt;
+            });
+            return it != info.end() && it->key == key;
+        };
+        return contains(old_info) || contains(new_info);
+    };
+    if (std::any_of(next_rows.begin(), next_rows.begin() + prefix, in_middle) ||
+        std::any_of(next_rows.end() - suffix, next_rows.end(), in_middle)) {
+        calculate(ret, build_row_info(prev_rows, 0, prev_rows.size()),
+                  build_row_info(next_rows, 0, next_rows.size()), key_did_change, in_table_order, 0);
+        return;
+    }
+
+    for (size_t i = 0; i < prefix; ++i) {
+        if (key_did_change(to_int64_t(next_rows[i])))
+            ret.modifications.add(i);
+    }
+    for (size_t i = next_rows.size() - suffix; i < next_rows.size(); ++i) {
+        if (key_did_change(to_int64_t(next_rows[i])))
+            ret.modifications.add(i);
+    }
+    if (!old_info.empty() || !new_info.empty())
+        calculate(ret, std::move(old_info), std::move(new_info), key_did_change, in_table_order, prefix);
+}
+
 } // Anonymous namespace
 
 CollectionChangeBuilder CollectionChangeBuilder::calculate(const ObjKeys& prev_objs, const ObjKeys& next_objs,
@@ -663,8 +764,8 @@ CollectionChangeBuilder CollectionChangeBuilder::calculate(const ObjKeys& prev_o
                                                            bool in_table_order)
 {
     CollectionChangeBuilder ret;
-    ::calculate(
-        ret, build_row_info(prev_objs), build_row_info(next_objs),
+    calculate_trimmed(
+        ret, prev_objs, next_objs,
         [&key_did_change](int64_t key) {
             return key_did_change(ObjKey(key));
         },
@@ -679,8 +780,8 @@ CollectionChangeBuilder CollectionChangeBuilder::calculate(std::vector<size_t> c
                                                            util::FunctionRef<bool(size_t)> ndx_did_change)
 {
     CollectionChangeBuilder ret;
-    ::calculate(
-        ret, build_row_info(prev_rows), build_row_info(next_rows),
+    calculate_trimmed(
+        ret, prev_rows, next_rows,
         [&ndx_did_change](int64_t ndx) {
             return ndx_did_change(size_t(ndx));
         },
@@ -702,7 +803,9 @@ CollectionChangeSet CollectionChangeBuilder::finalize() &&
     // but we don't want inserts in the final modification set
     modifications.remove(insertions);
 
-    return {std::move(deletions),     std::move(insertions), std::move(modifications_in_old),
-            std::move(modifications), std::move(moves),      collection_root_was_deleted,
-            collection_was_cleared,   std::move(columns)};
+    CollectionChangeSet ret{std::move(deletions),     std::move(insertions), std::move(modifications_in_old),
+                            std::move(modifications), std::move(moves),      collection_root_was_deleted,
+                            collection_was_cleared,   std::move(columns)};
+    ret.changes_skipped = changes_skipped;
+    return ret;
 }
@@ -286,6 +286,16 @@ void CollectionNotifier::add_required_change_info(TransactionChangeInfo& info)
     info.tables.reserve(m_related_tables.size());
     for (auto& tbl : m_related_tables)
         info.tables[tbl.table_key];
+
+    // Unfiltered checks for changes through links can share one search for
+    // objects linking to modified objects with the other notifiers
+    if (m_related_tables.size() > 1 && !m_all_callbacks_filtered) {
+        if (!info.reachable_from_modified)
+            info.reachable_from_modified = std::make_unique<ModifiedObjectReachability>();
+        info.reachable_from_modified->add_user();
+        for (auto& tbl : m_related_tables)
+            info.reachable_from_modified->add_related_table(tbl.table_key);
+    }
 }
 
 void CollectionNotifier::update_related_tables(Table const& table)
@@ -484,6 +494,7 @@ void CollectionNotifier::add_changes(CollectionChangeBuilder change)
             // skipped, so if we already have some changes something went wrong.
             REALM_ASSERT_DEBUG(callback.accumulated_changes.empty());
             callback.skip_next = false;
+            callback.accumulated_changes.changes_skipped = true;
         }
         else {
             // Only copy the changeset if there's more callbacks that need it
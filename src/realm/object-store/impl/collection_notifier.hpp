@@ -32,6 +32,7 @@
 #include <exception>
 #include <functional>
 #include <mutex>
+#include <string_view>
 #include <unordered_set>
 #include <chrono>
 
@@ -171,6 +172,23 @@ public:
     // precondition: RealmCoordinator::m_notifier_mutex is unlocked
     virtual void run() = 0;
 
+    // Notifiers which return the same non-empty key compute identical results
+    // when run on the same transaction, so all but the first one to run can
+    // reuse its results via run_from() rather than computing them again.
+    virtual std::string_view shared_run_key() const noexcept
+    {
+        return {};
+    }
+    // Run using the results computed by `source`, which has the same shared
+    // run key and has already been run on the same transaction. Returns false
+    // if `source` had nothing to reuse and this notifier ran on its own.
+    // precondition: RealmCoordinator::m_notifier_mutex is unlocked
+    virtual bool run_from(CollectionNotifier&)
+    {
+        run();
+        return false;
+    }
+
     // precondition: RealmCoordinator::m_notifier_mutex is locked
     void prepare_handover() REQUIRES(!m_callback_mutex);
 
@@ -34,6 +34,70 @@ void sort_and_unique(T& container)
 }
 } // namespace
 
+bool ModifiedObjectReachability::build(TransactionChangeInfo const& info, Group const& group)
+{
+    std::call_once(m_built, [&] {
+        do_build(info, group);
+    });
+    return !m_too_many_modified;
+}
+
+void ModifiedObjectReachability::do_build(TransactionChangeInfo const& info, Group const& group)
+{
+    size_t modified = 0;
+    for (auto& [table_key, changes] : info.tables)
+        modified += changes.modifications_size();
+    if (modified > max_modified_objects) {
+        m_too_many_modified = true;
+        return;
+    }
+
+    std::vector<std::pair<TableKey, ObjKey>> current, next;
+    current.reserve(modified);
+    for (auto& [table_key, changes] : info.tables) {
+        auto& reachable = m_reachable[table_key];
+        for (auto& [obj_key, columns] : changes.get_modifications()) {
+            reachable.insert(obj_key);
+            current.push_back({table_key, obj_key});
+        }
+    }
+
+    // Each step finds the objects which link to an object found by the previous
+    // one. Any path from a user's root table only goes through its related
+    // tables, so links from other tables don't need to be followed.
+    for (size_t depth = 0; depth < max_depth && !current.empty(); ++depth) {
+        for (auto [table_key, obj_key] : current) {
+            auto table = group.get_table(table_key);
+            if (!table->is_valid(obj_key))
+                continue;
+            const Obj obj = table->get_object(obj_key);
+            table->for_each_backlink_column([&](ColKey backlink_col) {
+                auto origin_table_key = table->get_opposite_table_key(backlink_col);
+                if (!m_tables.count(origin_table_key))
+                    return IteratorControl::AdvanceToNext;
+                auto origin_table = group.get_table(origin_table_key);
+                auto origin_col = table->get_opposite_column(backlink_col);
+                auto& reachable = m_reachable[origin_table_key];
+                for (size_t i = 0, count = obj.get_backlink_count(*origin_table, origin_col); i < count; ++i) {
+                    auto origin_key = obj.get_backlink(*origin_table, origin_col, i);
+                    if (reachable.insert(origin_key).second)
+                        next.push_back({origin_table_key, origin_key});
+                }
+                return IteratorControl::AdvanceToNext;
+            });
+        }
+        current.swap(next);
+        next.clear();
+    }
+}
+
+bool ModifiedObjectReachability::contains(TableKey table_key, ObjKey object_key) const
+{
+    REALM_ASSERT(!m_too_many_modified);
+    auto it = m_reachable.find(table_key);
+    return it != m_reachable.end() && it->second.count(object_key);
+}
+
 void DeepChangeChecker::find_related_tables(std::vector<RelatedTable>& related_tables, Table const& table,
                                             const KeyPathArray& key_path_array)
 {
@@ -155,6 +219,11 @@ DeepChangeChecker::DeepChangeChecker(TransactionChangeInfo const& info, Table co
             }
         }
     }
+    // The shared set only answers the unfiltered question of whether any
+    // modified object can be reached
+    else if (auto& reachable = info.reachable_from_modified; reachable && reachable->is_shared()) {
+        m_reachable_from_modified = reachable.get();
+    }
 }
 
 bool DeepChangeChecker::do_check_mixed_for_link(Group& group, TableRef& cached_linked_table, Mixed value,
@@ -357,6 +426,12 @@ bool DeepChangeChecker::operator()(ObjKey key)
         return false;
     }
 
+    if (m_reachable_from_modified) {
+        if (m_reachable_from_modified->build(m_info, *m_root_table.get_parent_group()))
+            return m_reachable_from_modified->contains(m_root_table.get_key(), key);
+        m_reachable_from_modified = nullptr;
+    }
+
     // The object itself wasn't modified, so move on to check if any of the
     // objects it links to were modified.
     return check_row(m_root_table, key, m_filtered_columns, 0);
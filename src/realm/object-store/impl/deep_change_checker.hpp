@@ -24,6 +24,8 @@
 #include <realm/collection_parent.hpp>
 
 #include <array>
+#include <memory>
+#include <mutex>
 
 namespace realm {
 class CollectionBase;
@@ -46,10 +48,64 @@ struct CollectionChangeInfo {
     CollectionChangeBuilder* changes;
 };
 
+struct TransactionChangeInfo;
+
+/**
+ * The set of objects from which a modified object can be reached by following at most `max_depth` links.
+ * This is what an unfiltered `DeepChangeChecker` searches for, so when several notifiers use the same
+ * `TransactionChangeInfo` the set is built once, with a breadth-first search over backlinks starting from
+ * the modified objects, and shared by all of their checkers instead of each of them searching the links of
+ * each object they check.
+ */
+class ModifiedObjectReachability {
+public:
+    // The number of links followed from an object, matching the depth searched by `DeepChangeChecker`.
+    static constexpr size_t max_depth = 3;
+    // Searching from every modified object costs more than checking the objects in the results when a lot
+    // of objects were modified, so no set is built above this.
+    static constexpr size_t max_modified_objects = 50'000;
+
+    // Register a checker which will use the set, along with each of the tables related to its root table.
+    // Building the set is only worthwhile when it's shared.
+    // precondition: RealmCoordinator::m_notifier_mutex is locked
+    void add_user() noexcept
+    {
+        ++m_users;
+    }
+    void add_related_table(TableKey table_key)
+    {
+        m_tables.insert(table_key);
+    }
+    bool is_shared() const noexcept
+    {
+        return m_users > 1;
+    }
+
+    // Build the set the first time this is called for `info`, which must be fully populated by then. Returns
+    // false if there were too many modified objects to build it. Can be called concurrently.
+    bool build(TransactionChangeInfo const& info, Group const& group);
+
+    // Check if a modified object can be reached from the given object.
+    // precondition: build() returned true
+    bool contains(TableKey table_key, ObjKey object_key) const;
+
+private:
+    size_t m_users = 0;
+    // The tables related to any of the users. Links from other tables are not followed.
+    std::unordered_set<TableKey> m_tables;
+    std::once_flag m_built;
+    bool m_too_many_modified = false;
+    std::unordered_map<TableKey, std::unordered_set<ObjKey>> m_reachable;
+
+    void do_build(TransactionChangeInfo const& info, Group const& group);
+};
+
 struct TransactionChangeInfo {
     std::vector<CollectionChangeInfo> collections;
     std::unordered_map<TableKey, ObjectChangeSet> tables;
     bool schema_changed = false;
+    // Shared by the DeepChangeCheckers of the notifiers which registered as users in add_required_change_info()
+    std::unique_ptr<ModifiedObjectReachability> reachable_from_modified;
 };
 
 /**
@@ -149,6 +205,10 @@ protected:
 private:
     RelatedTables const& m_related_tables;
 
+    // The shared result of searching for links to modified objects, if it applies to this checker. It is
+    // built by the first checker which needs it.
+    ModifiedObjectReachability* m_reachable_from_modified = nullptr;
+
     std::unordered_map<TableKey, std::unordered_set<ObjKey>> m_not_modified;
 
     struct Path {
@@ -156,7 +216,7 @@ private:
         ColKey col_key;
         bool depth_exceeded;
     };
-    std::array<Path, 4> m_current_path;
+    std::array<Path, ModifiedObjectReachability::max_depth + 1> m_current_path;
 
     /**
      * Checks if a specific object, identified by it's `ObjKey` in a given `Table` was changed.
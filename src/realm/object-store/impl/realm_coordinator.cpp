@@ -44,9 +44,12 @@
 #include <realm/history.hpp>
 #include <realm/string_data.hpp>
 #include <realm/util/fifo_helper.hpp>
+#include <realm/util/function_ref.hpp>
 #include <realm/sync/config.hpp>
 
 #include <algorithm>
+#include <condition_variable>
+#include <thread>
 #include <unordered_map>
 
 using namespace realm;
@@ -55,6 +58,126 @@ using namespace realm::_impl;
 static auto& s_coordinator_mutex = *new std::mutex;
 static auto& s_coordinators_per_path = *new std::unordered_map<std::string, std::weak_ptr<RealmCoordinator>>;
 
+namespace {
+struct RetainedSchema {
+    std::string path;
+    Schema schema;
+    uint64_t schema_version;
+};
+// Guarded by s_coordinator_mutex. Only the most recently closed files are
+// kept, as each entry holds a full copy of the file's schema.
+constexpr size_t s_max_retained_schemas = 8;
+auto& s_retained_schemas = *new std::vector<RetainedSchema>;
+} // anonymous namespace
+
+namespace realm::_impl {
+// Threads which run the notifier groups that run_notifiers() does not run on
+// the calling thread. The threads are started when first needed and live as
+// long as the coordinator, so no threads are created for each commit.
+class NotifierWorkerPool {
+public:
+    explicit NotifierWorkerPool(size_t max_threads)
+        : m_max_threads(max_threads)
+    {
+        REALM_ASSERT(max_threads > 0);
+    }
+
+    ~NotifierWorkerPool()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stop = true;
+        }
+        m_work_cv.notify_all();
+        for (auto& thread : m_threads)
+            thread.join();
+    }
+
+    // Runs `task(0)` to `task(num_tasks - 1)` on the worker threads while the
+    // calling thread runs `local`, and returns once all of them have
+    // completed. The first exception thrown by any of them is rethrown.
+    void run(size_t num_tasks, util::FunctionRef<void(size_t)> task, util::FunctionRef<void()> local)
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            REALM_ASSERT(m_num_tasks == 0);
+            while (m_threads.size() < std::min(num_tasks, m_max_threads)) {
+                m_threads.emplace_back([this] {
+                    worker_loop();
+                }); // Throws
+            }
+            m_task = &task;
+            m_num_tasks = num_tasks;
+            m_next_task = 0;
+            m_num_completed = 0;
+            m_error = nullptr;
+        }
+        m_work_cv.notify_all();
+
+        std::exception_ptr error;
+        try {
+            local();
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+
+        std::unique_lock lock(m_mutex);
+        m_done_cv.wait(lock, [&] {
+            return m_num_completed == m_num_tasks;
+        });
+        if (!error)
+            error = m_error;
+        m_task = nullptr;
+        m_num_tasks = 0;
+        m_error = nullptr;
+        lock.unlock();
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+private:
+    const size_t m_max_threads;
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_work_cv;
+    std::condition_variable m_done_cv;
+    const util::FunctionRef<void(size_t)>* m_task = nullptr;
+    size_t m_num_tasks = 0;
+    size_t m_next_task = 0;
+    size_t m_num_completed = 0;
+    std::exception_ptr m_error;
+    bool m_stop = false;
+
+    void worker_loop()
+    {
+        std::unique_lock lock(m_mutex);
+        for (;;) {
+            m_work_cv.wait(lock, [&] {
+                return m_stop || m_next_task < m_num_tasks;
+            });
+            if (m_stop)
+                return;
+            size_t ndx = m_next_task++;
+            auto task = m_task;
+            lock.unlock();
+            std::exception_ptr error;
+            try {
+                (*task)(ndx);
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+            if (error && !m_error)
+                m_error = error;
+            if (++m_num_completed == m_num_tasks)
+                m_done_cv.notify_all();
+        }
+    }
+};
+} // namespace realm::_impl
+
 std::shared_ptr<RealmCoordinator> RealmCoordinator::get_coordinator(StringData path)
 {
     std::lock_guard<std::mutex> lock(s_coordinator_mutex);
@@ -444,6 +567,7 @@ bool RealmCoordinator::open_db()
         }
         if (m_sync_session) {
             m_db = SyncSession::Internal::get_db(*m_sync_session);
+            load_retained_schema_cache();
             init_external_helpers();
             return false;
         }
@@ -532,10 +656,57 @@ bool RealmCoordinator::open_db()
             m_db->compact();
     }
 
+    load_retained_schema_cache();
     init_external_helpers();
     return true;
 }
 
+void RealmCoordinator::retain_schema_cache() noexcept
+{
+    if (m_config.in_memory || m_config.realm_data || m_config.path.empty())
+        return;
+
+    util::CheckedLockGuard lock(m_schema_cache_mutex);
+    if (!m_cached_schema)
+        return;
+
+    std::lock_guard<std::mutex> coordinator_lock(s_coordinator_mutex);
+    auto it = std::find_if(s_retained_schemas.begin(), s_retained_schemas.end(), [&](auto& retained) {
+        return retained.path == m_config.path;
+    });
+    if (it != s_retained_schemas.end())
+        s_retained_schemas.erase(it);
+    else if (s_retained_schemas.size() == s_max_retained_schemas)
+        s_retained_schemas.erase(s_retained_schemas.begin());
+    s_retained_schemas.push_back({m_config.path, std::move(*m_cached_schema), m_schema_version});
+    m_cached_schema = util::none;
+}
+
+void RealmCoordinator::load_retained_schema_cache()
+{
+    util::Optional<RetainedSchema> retained;
+    {
+        std::lock_guard<std::mutex> coordinator_lock(s_coordinator_mutex);
+        auto it = std::find_if(s_retained_schemas.begin(), s_retained_schemas.end(), [&](auto& retained) {
+            return retained.path == m_config.path;
+        });
+        if (it == s_retained_schemas.end())
+            return;
+        retained = std::move(*it);
+        s_retained_schemas.erase(it);
+    }
+
+    // The file may have been modified or even replaced since the schema was
+    // cached, so verify that it still describes the file exactly. This is
+    // much cheaper than reading the schema from the file.
+    auto transaction = m_db->start_read();
+    if (ObjectStore::get_schema_version(*transaction) != retained->schema_version ||
+        !ObjectStore::schema_matches_group(*transaction, retained->schema))
+        return;
+    cache_schema(retained->schema, retained->schema_version,
+                 transaction->get_version_of_current_transaction().version);
+}
+
 void RealmCoordinator::init_external_helpers()
 {
     // There's a circular dependency between SyncSession and ExternalCommitHelper
@@ -591,6 +762,26 @@ TransactionRef RealmCoordinator::begin_read(VersionID version, bool frozen_trans
     return frozen_transaction ? m_db->start_frozen(version) : m_db->start_read(version);
 }
 
+TransactionRef RealmCoordinator::begin_shared_frozen_read(VersionID version)
+{
+    REALM_ASSERT(m_db);
+    util::CheckedLockGuard lock(m_frozen_transaction_mutex);
+    auto& cached = m_frozen_transactions[version.version];
+    if (auto transaction = cached.lock())
+        return transaction;
+
+    auto transaction = m_db->start_frozen(version);
+    cached = transaction;
+    // Drop the entries for versions which no Realm is reading any more
+    for (auto it = m_frozen_transactions.begin(); it != m_frozen_transactions.end();) {
+        if (it->second.expired())
+            it = m_frozen_transactions.erase(it);
+        else
+            ++it;
+    }
+    return transaction;
+}
+
 uint64_t RealmCoordinator::get_schema_version() const noexcept
 {
     util::CheckedLockGuard lock(m_schema_cache_mutex);
@@ -647,6 +838,7 @@ RealmCoordinator::RealmCoordinator(Private) {}
 
 RealmCoordinator::~RealmCoordinator()
 {
+    retain_schema_cache();
     {
         std::lock_guard<std::mutex> coordinator_lock(s_coordinator_mutex);
         for (auto it = s_coordinators_per_path.begin(); it != s_coordinators_per_path.end();) {
@@ -738,6 +930,7 @@ void RealmCoordinator::clear_all_caches()
         for (auto iter : s_coordinators_per_path) {
             to_clear.push_back(iter.second);
         }
+        s_retained_schemas.clear();
     }
     for (auto weak_coordinator : to_clear) {
         if (auto coordinator = weak_coordinator.lock()) {
@@ -868,6 +1061,8 @@ void RealmCoordinator::clean_up_dead_notifiers()
         m_notifier_transaction = nullptr;
         m_notifier_handover_transaction = nullptr;
         m_notifier_skip_version.reset();
+        m_notifier_worker_transactions.clear();
+        m_next_notifier_worker = 0;
     }
     swap_remove(m_new_notifiers);
 }
@@ -956,9 +1151,36 @@ void RealmCoordinator::run_async_notifiers()
 
     auto new_notifiers = std::move(m_new_notifiers);
     m_new_notifiers.clear();
+
+    // Pick the transaction each new notifier will run on from now on. Any
+    // transaction created for this is already at the final version. Notifiers
+    // for identical queries can only share work when they run on the same
+    // transaction, so those are kept together.
+    std::vector<TransactionRef> new_notifier_transactions;
+    new_notifier_transactions.reserve(new_notifiers.size());
+    for (size_t i = 0; i < new_notifiers.size(); ++i) {
+        TransactionRef tr;
+        if (auto key = new_notifiers[i]->shared_run_key(); !key.empty()) {
+            for (size_t j = 0; j < i && !tr; ++j) {
+                if (new_notifiers[j]->shared_run_key() == key)
+                    tr = new_notifier_transactions[j];
+            }
+            if (!tr)
+                tr = notifier_transaction_for_query(key);
+        }
+        new_notifier_transactions.push_back(tr ? std::move(tr) : notifier_transaction_for_new_notifier(version));
+    }
     m_notifiers.insert(m_notifiers.end(), new_notifiers.begin(), new_notifiers.end());
+    auto worker_transactions = m_notifier_worker_transactions;
     lock.unlock();
 
+    auto advance_workers = [&](VersionID target) {
+        for (auto& tr : worker_transactions) {
+            if (tr->get_version_of_current_transaction() < target)
+                tr->advance_read(target);
+        }
+    };
+
     // Advance all of the new notifiers to the most recent version, if any
     std::vector<TransactionChangeInfo> new_notifier_change_info;
     if (!new_notifiers.empty()) {
@@ -987,8 +1209,8 @@ void RealmCoordinator::run_async_notifiers()
         for (auto& notifier : notifiers)
             notifier->add_required_change_info(info);
         transaction::advance(*m_notifier_transaction, info, skip_version->get_version_of_current_transaction());
-        for (auto& notifier : notifiers)
-            notifier->run();
+        advance_workers(skip_version->get_version_of_current_transaction());
+        run_notifiers(notifiers);
 
         util::CheckedLockGuard lock(m_notifier_mutex);
         for (auto& notifier : notifiers)
@@ -1002,6 +1224,7 @@ void RealmCoordinator::run_async_notifiers()
         notifier->add_required_change_info(change_info);
     }
     transaction::advance(*m_notifier_transaction, change_info, version);
+    advance_workers(version);
 
     {
         // If there's multiple notifiers for a single collection, we only populate
@@ -1024,16 +1247,20 @@ void RealmCoordinator::run_async_notifiers()
     }
 
     // Now that they're at the same version, switch the new notifiers over to
-    // the main Transaction used for background work rather than the temporary one
-    for (auto& notifier : new_notifiers) {
-        notifier->attach_to(m_notifier_transaction);
-        notifier->run();
+    // the Transactions used for background work rather than the temporary one
+    for (size_t i = 0; i < new_notifiers.size(); ++i) {
+        new_notifiers[i]->attach_to(std::move(new_notifier_transactions[i]));
     }
 
     // Change info is now all ready, so the notifiers can now perform their
     // background work
-    for (auto& notifier : notifiers) {
-        notifier->run();
+    if (new_notifiers.empty()) {
+        run_notifiers(notifiers);
+    }
+    else {
+        auto all_notifiers = new_notifiers;
+        all_notifiers.insert(all_notifiers.end(), notifiers.begin(), notifiers.end());
+        run_notifiers(all_notifiers);
     }
 
     // Reacquire the lock while updating the fields that are actually read on
@@ -1050,6 +1277,84 @@ void RealmCoordinator::run_async_notifiers()
         m_notifier_handover_transaction = m_db->start_read(version);
 }
 
+std::shared_ptr<Transaction> RealmCoordinator::notifier_transaction_for_new_notifier(VersionID version)
+{
+    size_t thread_count = std::max<size_t>(m_config.max_notifier_threads, 1);
+    size_t ndx = m_next_notifier_worker++ % thread_count;
+    if (ndx == 0)
+        return m_notifier_transaction;
+    if (m_notifier_worker_transactions.size() < ndx)
+        m_notifier_worker_transactions.push_back(m_db->start_read(version));
+    return m_notifier_worker_transactions[ndx - 1];
+}
+
+std::shared_ptr<Transaction> RealmCoordinator::notifier_transaction_for_query(std::string_view key)
+{
+    for (auto& notifier : m_notifiers) {
+        if (notifier->shared_run_key() != key)
+            continue;
+        if (&notifier->transaction() == m_notifier_transaction.get())
+            return m_notifier_transaction;
+        for (auto& tr : m_notifier_worker_transactions) {
+            if (&notifier->transaction() == tr.get())
+                return tr;
+        }
+    }
+    return nullptr;
+}
+
+void RealmCoordinator::run_notifiers(NotifierVector const& notifiers)
+{
+    // Notifiers attached to the same transaction must run on the same thread, but
+    // the groups for different transactions are independent of each other.
+    std::vector<NotifierVector> groups;
+    for (auto& notifier : notifiers) {
+        auto it = std::find_if(groups.begin(), groups.end(), [&](auto& group) {
+            return &group.front()->transaction() == &notifier->transaction();
+        });
+        if (it == groups.end())
+            groups.push_back({notifier});
+        else
+            it->push_back(notifier);
+    }
+
+    auto run_group = [](NotifierVector const& group) {
+        // Notifiers for identical queries reuse the results of the first of
+        // them which actually ran the query
+        std::unordered_map<std::string_view, CollectionNotifier*> sources;
+        for (auto& notifier : group) {
+            auto key = notifier->shared_run_key();
+            if (key.empty()) {
+                notifier->run();
+                continue;
+            }
+            auto [it, inserted] = sources.emplace(key, notifier.get());
+            if (inserted)
+                notifier->run();
+            else if (!notifier->run_from(*it->second))
+                it->second = notifier.get();
+        }
+    };
+    if (groups.size() <= 1) {
+        if (!groups.empty())
+            run_group(groups.front());
+        return;
+    }
+
+    if (!m_notifier_worker_pool) {
+        size_t max_threads = std::max<size_t>(m_config.max_notifier_threads, 2) - 1;
+        m_notifier_worker_pool = std::make_unique<NotifierWorkerPool>(max_threads);
+    }
+    m_notifier_worker_pool->run(
+        groups.size() - 1,
+        [&](size_t i) {
+            run_group(groups[i + 1]);
+        },
+        [&] {
+            run_group(groups.front());
+        });
+}
+
 void RealmCoordinator::advance_to_ready(Realm& realm)
 {
     // If callbacks close the Realm the last external reference may go away
@@ -25,6 +25,7 @@
 #include <realm/version_id.hpp>
 
 #include <condition_variable>
+#include <map>
 #include <mutex>
 
 namespace realm {
@@ -37,6 +38,7 @@ class Transaction;
 namespace _impl {
 class CollectionNotifier;
 class ExternalCommitHelper;
+class NotifierWorkerPool;
 class WeakRealmNotifier;
 
 // RealmCoordinator manages the weak cache of Realm instances and communication
@@ -170,6 +172,10 @@ public:
     static void register_notifier(std::shared_ptr<CollectionNotifier> notifier);
 
     TransactionRef begin_read(VersionID version = {}, bool frozen_transaction = false);
+    // Returns a frozen transaction at the given version. The transaction is
+    // shared with any other frozen Realm at that version, and is released when
+    // the last of them is closed.
+    TransactionRef begin_shared_frozen_read(VersionID version) REQUIRES(!m_frozen_transaction_mutex);
 
     // Returns true if there are any versions after the Realm's read version
     bool can_advance(Realm& realm);
@@ -247,6 +253,10 @@ private:
     util::CheckedMutex m_realm_mutex;
     std::vector<WeakRealmNotifier> m_weak_realm_notifiers GUARDED_BY(m_realm_mutex);
 
+    util::CheckedMutex m_frozen_transaction_mutex;
+    std::map<DB::version_type, std::weak_ptr<Transaction>> m_frozen_transactions
+        GUARDED_BY(m_frozen_transaction_mutex);
+
     util::CheckedMutex m_notifier_mutex;
     NotifierVector m_new_notifiers GUARDED_BY(m_notifier_mutex);
     NotifierVector m_notifiers GUARDED_BY(m_notifier_mutex);
@@ -259,6 +269,13 @@ private:
     // Transaction used to pin the version which notifiers are currently ready
     // to deliver to
     std::shared_ptr<Transaction> m_notifier_handover_transaction;
+    // Additional transactions at the same version as m_notifier_transaction when
+    // notifiers are run on more than one thread. Each notifier stays attached to
+    // the transaction it was given when it was first run.
+    std::vector<std::shared_ptr<Transaction>> m_notifier_worker_transactions;
+    size_t m_next_notifier_worker = 0;
+    // Threads running the notifiers of the worker transactions
+    std::unique_ptr<NotifierWorkerPool> m_notifier_worker_pool;
 
     std::unique_ptr<_impl::ExternalCommitHelper> m_notifier;
 
@@ -269,7 +286,13 @@ private:
     std::shared_ptr<AuditInterface> m_audit_context;
 
     // returns true the first time the database is opened, false otherwise.
-    bool open_db() REQUIRES(m_realm_mutex);
+    bool open_db() REQUIRES(m_realm_mutex, !m_schema_cache_mutex);
+
+    // The schema cache outlives the coordinator so that reopening a file with
+    // a large schema doesn't have to build the schema again. The retained
+    // schema is only used if it still exactly matches the file.
+    void retain_schema_cache() noexcept REQUIRES(!m_schema_cache_mutex);
+    void load_retained_schema_cache() REQUIRES(!m_schema_cache_mutex);
 
     void set_config(const Realm::Config&) REQUIRES(m_realm_mutex, !m_schema_cache_mutex);
     void init_external_helpers() REQUIRES(m_realm_mutex);
@@ -280,6 +303,9 @@ private:
     void do_get_realm(Realm::Config&& config, std::shared_ptr<Realm>& realm, util::Optional<VersionID> version,
                       util::CheckedUniqueLock& realm_lock, bool first_time_open = false) REQUIRES(m_realm_mutex);
     void run_async_notifiers() REQUIRES(!m_notifier_mutex, m_running_notifiers_mutex);
+    std::shared_ptr<Transaction> notifier_transaction_for_new_notifier(VersionID version) REQUIRES(m_notifier_mutex);
+    std::shared_ptr<Transaction> notifier_transaction_for_query(std::string_view key) REQUIRES(m_notifier_mutex);
+    void run_notifiers(NotifierVector const& notifiers) REQUIRES(m_running_notifiers_mutex);
     void clean_up_dead_notifiers() REQUIRES(m_notifier_mutex);
 
     NotifierVector notifiers_for_realm(Realm&) REQUIRES(m_notifier_mutex);
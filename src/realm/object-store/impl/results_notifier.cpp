@@ -21,6 +21,7 @@
 #include <realm/object-store/shared_realm.hpp>
 #include <realm/util/scope_exit.hpp>
 
+#include <algorithm>
 #include <numeric>
 
 using namespace realm;
@@ -37,7 +38,7 @@ using namespace realm::_impl;
 //   * do_attach_to() called with notifier lock held
 //     - Writes to m_query
 //   * do_add_required_change_info() called with notifier lock held
-//     - Writes to m_info
+//     - Writes to m_info, m_info_base_version and m_info_has_changes
 //   * run() called with no locks held
 //     - Reads m_query
 //     - Reads m_info
@@ -73,6 +74,17 @@ ResultsNotifier::ResultsNotifier(Results& target)
         m_logger->log(util::LogCategory::notification, util::Logger::Level::debug, "Creating ResultsNotifier for %1",
                       m_description);
     }
+    // The description of a query restricted to a view doesn't identify the view,
+    // and queries which can't be serialized can't be shared
+    if (auto table = m_query->get_table(); table && m_query->produces_results_in_table_order()) {
+        try {
+            m_shared_run_key = util::format("%1 %2 %3", table->get_key().value, m_query->get_description(),
+                                            m_descriptor_ordering.get_description(table));
+        }
+        catch (const std::exception&) {
+            m_shared_run_key.clear();
+        }
+    }
     reattach();
 }
 
@@ -114,7 +126,9 @@ bool ResultsNotifier::do_add_required_change_info(TransactionChangeInfo& info)
         update_related_tables(*m_query->get_table());
     }
 
-    return m_query->get_table() && has_run() && have_callbacks();
+    m_info_base_version = transaction().get_version_of_current_transaction();
+    m_info_has_changes = m_query->get_table() && has_run() && have_callbacks();
+    return m_info_has_changes;
 }
 
 void ResultsNotifier::calculate_changes()
@@ -147,9 +161,80 @@ void ResultsNotifier::calculate_changes()
         for (size_t i = 0; i < sz; ++i)
             m_previous_objs[i] = m_run_tv.get_key(i);
     }
+    m_previous_objs_version = transaction().get_version_of_current_transaction();
+}
+
+bool ResultsNotifier::update_incrementally(const TableVersions& new_versions)
+{
+    // The previous results can be updated from the object changes when they are
+    // in table order and the query only reads the queried table. Anything else
+    // (links, sorting, distinct, limits) can change whether or where an object
+    // is included without that object being modified.
+    auto table = m_query->get_table();
+    if (!m_info_has_changes || m_info->schema_changed || m_previous_objs_version != m_info_base_version)
+        return false;
+    if (!m_target_is_in_table_order || !m_descriptor_ordering.is_empty())
+        return false;
+    // Links can stay inside the queried table (e.g. `parent.age > 5`), so the
+    // number of dependency tables does not say whether links are followed
+    if (new_versions.size() != 1 || new_versions[0].first != table->get_key() || m_query->follows_links())
+        return false;
+    auto it = m_info->tables.find(table->get_key());
+    if (it == m_info->tables.end())
+        return false;
+    auto& changes = it->second;
+
+    // Re-evaluating the query on each object is more expensive per object than
+    // running it, so only do so when a small part of the table was touched
+    std::vector<ObjKey> touched;
+    touched.reserve(changes.insertions_size() + changes.modifications_size());
+    for (auto key : changes.get_insertions())
+        touched.push_back(key);
+    for (auto& [key, columns] : changes.get_modifications())
+        touched.push_back(key);
+    if (touched.size() > table->size() / 8)
+        return false;
+    std::sort(touched.begin(), touched.end());
+    touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+    auto matching = m_query->eval_objects(touched);
+
+    // Merge the previous results, minus deleted and touched objects, with the
+    // touched objects which now match. Both are ordered by key, which is table
+    // order.
+    REALM_ASSERT_DEBUG(std::is_sorted(m_previous_objs.begin(), m_previous_objs.end()));
+    std::vector<ObjKey> next;
+    next.reserve(m_previous_objs.size() + matching.size());
+    auto touched_it = touched.begin();
+    auto matching_it = matching.begin();
+    for (auto key : m_previous_objs) {
+        while (matching_it != matching.end() && *matching_it < key)
+            next.push_back(*matching_it++);
+        while (touched_it != touched.end() && *touched_it < key)
+            ++touched_it;
+        if (touched_it != touched.end() && *touched_it == key)
+            continue;
+        if (!changes.deletions_contains(key))
+            next.push_back(key);
+    }
+    next.insert(next.end(), matching_it, matching.end());
+
+    m_run_tv = TableView(*m_query, size_t(-1));
+    m_run_tv.set_query_result(next);
+    return true;
 }
 
 void ResultsNotifier::run()
+{
+    do_run(nullptr);
+}
+
+bool ResultsNotifier::run_from(CollectionNotifier& source)
+{
+    REALM_ASSERT(&source.transaction() == &transaction());
+    return do_run(&static_cast<ResultsNotifier&>(source));
+}
+
+bool ResultsNotifier::do_run(ResultsNotifier* source)
 {
     NotifierRunLogger log(m_logger.get(), "ResultsNotifier", m_description);
 
@@ -160,14 +245,14 @@ void ResultsNotifier::run()
         m_change = {};
         m_change.deletions.set(m_previous_objs.size());
         m_previous_objs.clear();
-        return;
+        return false;
     }
 
     {
         auto lock = lock_target();
         // Don't run the query if the results aren't actually going to be used
         if (!get_realm() || (!have_callbacks() && !m_results_were_used))
-            return;
+            return false;
     }
 
     auto new_versions = m_query->sync_view_if_needed();
@@ -177,8 +262,9 @@ void ResultsNotifier::run()
         // We've run previously and none of the tables involved in the query
         // changed so we don't need to rerun the query, but we still need to
         // check each object in the results to see if it was modified
+        m_previous_objs_version = transaction().get_version_of_current_transaction();
         if (!any_related_table_was_modified(*m_info))
-            return;
+            return false;
         REALM_ASSERT(m_change.empty());
         auto checker = get_modification_checker(*m_info, m_query->get_table());
         for (size_t i = 0; i < m_previous_objs.size(); ++i) {
@@ -186,15 +272,24 @@ void ResultsNotifier::run()
                 m_change.modifications.add(i);
             }
         }
-        return;
+        return false;
     }
 
-    m_run_tv = TableView(*m_query, size_t(-1));
-    // Syncing will be done here
-    m_run_tv.apply_descriptor_ordering(m_descriptor_ordering);
+    // The source ran an identical query on this transaction, so if it ran it
+    // at these table versions its results are our results
+    bool used_source = source && source->m_run_tv.is_attached() && source->m_last_seen_version == new_versions;
+    if (used_source) {
+        m_run_tv = source->m_run_tv;
+    }
+    else if (!has_run() || !update_incrementally(new_versions)) {
+        m_run_tv = TableView(*m_query, size_t(-1));
+        // Syncing will be done here
+        m_run_tv.apply_descriptor_ordering(m_descriptor_ordering);
+    }
     m_last_seen_version = std::move(new_versions);
 
     calculate_changes();
+    return used_source;
 }
 
 void ResultsNotifier::do_prepare_handover(Transaction& sg)
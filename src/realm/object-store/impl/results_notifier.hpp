@@ -71,13 +71,30 @@ private:
 
     // The objects from the previous run of the query, for calculating diffs
     ObjKeys m_previous_objs;
+    // The version m_previous_objs is the result of the query for
+    VersionID m_previous_objs_version;
 
     TransactionChangeInfo* m_info = nullptr;
+    // The version the changes in m_info start from, and whether object changes
+    // for the queried table were requested
+    VersionID m_info_base_version;
+    bool m_info_has_changes = false;
     bool m_results_were_used = true;
 
+    // Identifies the table, query and ordering so that notifiers for identical
+    // queries can share one evaluation. Empty if the query can't be shared.
+    std::string m_shared_run_key;
+
     void calculate_changes();
+    bool update_incrementally(const TableVersions& new_versions);
+    bool do_run(ResultsNotifier* source);
 
     void run() override;
+    std::string_view shared_run_key() const noexcept override
+    {
+        return m_shared_run_key;
+    }
+    bool run_from(CollectionNotifier& source) override;
     void do_prepare_handover(Transaction&) override;
     bool do_add_required_change_info(TransactionChangeInfo& info) override;
     bool prepare_to_deliver() override;
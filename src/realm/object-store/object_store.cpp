@@ -967,6 +967,45 @@ Schema ObjectStore::schema_from_group(Group const& group)
     return schema;
 }
 
+bool ObjectStore::schema_matches_group(Group const& group, Schema const& schema)
+{
+    size_t object_types = 0;
+    for (auto key : group.get_table_keys()) {
+        auto object_type = object_type_for_table_name(group.get_table_name(key));
+        if (!object_type.size())
+            continue;
+        ++object_types;
+
+        auto it = schema.find(object_type);
+        if (it == schema.end() || it->table_key != key || !it->computed_properties.empty())
+            return false;
+        auto table = group.get_table(key);
+        if (it->table_type != static_cast<ObjectSchema::ObjectType>(table->get_table_type()))
+            return false;
+        if (it->persisted_properties.size() != table->get_column_count())
+            return false;
+        ColKey pk_col = table->get_primary_key_column();
+        if (pk_col ? it->primary_key != table->get_column_name(pk_col) : !it->primary_key.empty())
+            return false;
+
+        // schema_from_group() creates the properties in column order
+        size_t ndx = 0;
+        for (auto col_key : table->get_column_keys()) {
+            auto& property = it->persisted_properties[ndx++];
+            if (property.column_key != col_key || property.name != table->get_column_name(col_key))
+                return false;
+            auto index_type = table->search_index_type(col_key);
+            if (bool(property.is_indexed) != (index_type == IndexType::General) ||
+                bool(property.is_fulltext_indexed) != (index_type == IndexType::Fulltext))
+                return false;
+            if (property.type == PropertyType::Object &&
+                property.object_type != object_type_for_table_name(table->get_link_target(col_key)->get_name()))
+                return false;
+        }
+    }
+    return object_types == schema.size();
+}
+
 void ObjectStore::set_schema_keys(Group const& group, Schema& schema)
 {
     for (auto& object_schema : schema) {
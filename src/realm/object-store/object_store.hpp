@@ -97,6 +97,11 @@ public:
     // get existing Schema from a group
     static Schema schema_from_group(Group const& group);
 
+    // check if the given schema is exactly what schema_from_group() would
+    // produce for this group, including table and column keys. This is much
+    // cheaper than building a new schema as it doesn't allocate.
+    static bool schema_matches_group(Group const& group, Schema const& schema);
+
     static void set_schema_keys(Group const& group, Schema& schema);
 
     // deletes the table for the given type
@@ -1151,6 +1151,17 @@ Results Results::import_copy_into_realm(std::shared_ptr<Realm> const& realm)
 
     validate_read();
 
+    // Frozen Realms at the same version share a transaction, so the table
+    // accessors and any evaluated query results can be used as-is. Collection
+    // accessors are not safe to share between threads, so they are still
+    // imported.
+    if (m_mode != Mode::Collection && m_realm->is_frozen() && realm->is_frozen() &&
+        &m_realm->read_group() == &realm->read_group()) {
+        Results results(*this);
+        results.m_realm = realm;
+        return results;
+    }
+
     switch (m_mode) {
         case Mode::Table:
             return Results(realm, realm->import_copy_of(m_table));
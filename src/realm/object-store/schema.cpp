@@ -256,11 +256,25 @@ void Schema::validate(SchemaValidationMode validation_mode) const
     }
 }
 
+// The properties of two versions of the same type are almost always in the
+// same order, so check the property at the same position before searching the
+// whole type for it. Property names within a type are unique.
+template <typename ObjectSchemaT>
+static auto find_property(ObjectSchemaT& object_schema, size_t ndx, StringData name)
+    -> decltype(object_schema.property_for_name(name))
+{
+    auto& properties = object_schema.persisted_properties;
+    if (ndx < properties.size() && properties[ndx].name == name)
+        return &properties[ndx];
+    return object_schema.property_for_name(name);
+}
+
 static void compare(ObjectSchema const& existing_schema, ObjectSchema const& target_schema,
                     std::vector<SchemaChange>& changes)
 {
-    for (auto& current_prop : existing_schema.persisted_properties) {
-        auto target_prop = target_schema.property_for_name(current_prop.name);
+    for (size_t ndx = 0; ndx < existing_schema.persisted_properties.size(); ++ndx) {
+        auto& current_prop = existing_schema.persisted_properties[ndx];
+        auto target_prop = find_property(target_schema, ndx, current_prop.name);
 
         if (!target_prop) {
             changes.emplace_back(schema_change::RemoveProperty{&existing_schema, &current_prop});
@@ -300,8 +314,9 @@ static void compare(ObjectSchema const& existing_schema, ObjectSchema const& tar
         }
     }
 
-    for (auto& target_prop : target_schema.persisted_properties) {
-        if (!existing_schema.property_for_name(target_prop.name)) {
+    for (size_t ndx = 0; ndx < target_schema.persisted_properties.size(); ++ndx) {
+        auto& target_prop = target_schema.persisted_properties[ndx];
+        if (!find_property(existing_schema, ndx, target_prop.name)) {
             changes.emplace_back(schema_change::AddProperty{&existing_schema, &target_prop});
         }
     }
@@ -390,8 +405,9 @@ void Schema::copy_keys_from(realm::Schema const& other, SchemaSubsetMode subset_
             return;
 
         existing->table_key = other->table_key;
-        for (auto& current_prop : other->persisted_properties) {
-            if (auto target_prop = existing->property_for_name(current_prop.name)) {
+        for (size_t ndx = 0; ndx < other->persisted_properties.size(); ++ndx) {
+            auto& current_prop = other->persisted_properties[ndx];
+            if (auto target_prop = find_property(*existing, ndx, current_prop.name)) {
                 target_prop->column_key = current_prop.column_key;
             }
             else if (subset_mode.include_properties) {
@@ -83,12 +83,13 @@ struct IndexSetAdder {
 struct SectionedResultsNotificationHandler {
 public:
     SectionedResultsNotificationHandler(SectionedResults& sectioned_results,
-                                        SectionedResultsNotificationCallback&& cb,
+                                        SectionedResultsNotificationCallback&& cb, bool has_key_path_filter,
                                         util::Optional<Mixed> section_filter = util::none)
         : m_cb(std::move(cb))
         , m_sectioned_results(sectioned_results)
         , m_prev_row_to_index_path(m_sectioned_results.m_row_to_index_path)
         , m_section_filter(section_filter)
+        , m_has_key_path_filter(has_key_path_filter)
     {
     }
 
@@ -96,7 +97,15 @@ public:
     {
         util::CheckedUniqueLock lock(m_sectioned_results.m_mutex);
 
-        m_sectioned_results.calculate_sections_if_required();
+        // The change set can be used to update the sections if the sections
+        // were last calculated when this callback was last called. With a key
+        // path filter it may be missing modifications which change the section
+        // key, the changes of a suppressed notification are left out, and the
+        // initial notification has no changes.
+        bool changes_apply = !m_has_key_path_filter && !c.changes_skipped && m_last_calculation &&
+                             *m_last_calculation == m_sectioned_results.m_calculation_count;
+        m_sectioned_results.calculate_sections_if_required(changes_apply ? &c : nullptr);
+        m_last_calculation = m_sectioned_results.m_calculation_count;
         section_initial_changes(c);
         m_prev_row_to_index_path = m_sectioned_results.m_row_to_index_path;
 
@@ -187,6 +196,9 @@ private:
     // change indices referring to the supplied section key.
     util::Optional<Mixed> m_section_filter;
     bool m_section_filter_should_deliver_initial_notification = true;
+    bool m_has_key_path_filter;
+    // The value of SectionedResults::m_calculation_count after the last call
+    util::Optional<uint64_t> m_last_calculation;
 
     // Group the changes in the changeset by the section
     void section_initial_changes(CollectionChangeSet const& c) REQUIRES(m_sectioned_results.m_mutex)
@@ -388,7 +400,7 @@ SectionedResults::SectionedResults(Results results, Results::SectionedResultsOpe
 {
 }
 
-void SectionedResults::calculate_sections_if_required()
+void SectionedResults::calculate_sections_if_required(CollectionChangeSet const* changes)
 {
     if (m_results.m_update_policy == Results::UpdatePolicy::Never)
         return;
@@ -400,13 +412,61 @@ void SectionedResults::calculate_sections_if_required()
         m_results.ensure_up_to_date();
     }
 
-    calculate_sections();
+    calculate_sections(changes);
+}
+
+Mixed SectionedResults::compute_section_key(size_t row)
+{
+    Mixed key = m_callback(m_results.get_any(row), m_results.get_realm());
+    // Disallow links as section keys. It would be uncommon to use them to begin with
+    // and if the object acting as the key was deleted bad things would happen.
+    if (key.is_type(type_Link, type_TypedLink)) {
+        throw InvalidArgument("Links are not supported as section keys.");
+    }
+    return key;
+}
+
+// Carry the keys of the rows which were neither inserted nor modified over to
+// their new positions and compute the keys of the others. Returns false if the
+// change set doesn't match the number of rows.
+bool SectionedResults::update_row_keys(CollectionChangeSet const& changes, size_t size)
+{
+    size_t old_size = m_row_to_key.size();
+    size_t deleted = changes.deletions.count();
+    if (deleted > old_size || old_size - deleted + changes.insertions.count() != size)
+        return false;
+
+    std::vector<Mixed> row_to_key;
+    row_to_key.reserve(size);
+    auto deletions = changes.deletions.as_indexes();
+    auto insertions = changes.insertions.as_indexes();
+    auto deletion = deletions.begin();
+    auto insertion = insertions.begin();
+    size_t old_row = 0;
+    for (size_t row = 0; row < size; ++row) {
+        if (insertion != insertions.end() && *insertion == row) {
+            row_to_key.push_back(compute_section_key(row));
+            ++insertion;
+            continue;
+        }
+        for (; deletion != deletions.end() && *deletion == old_row; ++deletion)
+            ++old_row;
+        if (old_row >= old_size)
+            return false;
+        row_to_key.push_back(m_row_to_key[old_row++]);
+    }
+    for (auto row : changes.modifications_new.as_indexes()) {
+        if (!changes.insertions.contains(row))
+            row_to_key[row] = compute_section_key(row);
+    }
+    m_row_to_key = std::move(row_to_key);
+    return true;
 }
 
 // This method will run in the following scenarios:
 // - SectionedResults is performing its initial evaluation.
 // - The underlying Table in the Results collection has changed
-void SectionedResults::calculate_sections()
+void SectionedResults::calculate_sections(CollectionChangeSet const* changes)
 {
     m_previous_str_buffers.clear();
     m_previous_str_buffers.swap(m_current_str_buffers);
@@ -422,14 +482,16 @@ void SectionedResults::calculate_sections()
     size_t size = m_results.size();
     m_row_to_index_path.resize(size);
 
-    for (size_t i = 0; i < size; ++i) {
-        Mixed key = m_callback(m_results.get_any(i), m_results.get_realm());
-        // Disallow links as section keys. It would be uncommon to use them to begin with
-        // and if the object acting as the key was deleted bad things would happen.
-        if (key.is_type(type_Link, type_TypedLink)) {
-            throw InvalidArgument("Links are not supported as section keys.");
-        }
+    if (!changes || !m_has_performed_initial_evaluation || !update_row_keys(*changes, size)) {
+        std::vector<Mixed> row_to_key;
+        row_to_key.reserve(size);
+        for (size_t i = 0; i < size; ++i)
+            row_to_key.push_back(compute_section_key(i));
+        m_row_to_key = std::move(row_to_key);
+    }
 
+    for (size_t i = 0; i < size; ++i) {
+        Mixed& key = m_row_to_key[i];
         auto it = m_current_key_to_index.find(key);
         if (it == m_current_key_to_index.end()) {
             create_buffered_key(key, m_current_str_buffers);
@@ -440,6 +502,9 @@ void SectionedResults::calculate_sections()
         }
         else {
             auto& section = m_sections[it->second];
+            // Refer to this calculation's copy of the key so that the previous
+            // buffers can be released by the next one
+            key = section.key;
             section.indices.push_back(i);
             m_row_to_index_path[i] = {section.index, section.indices.size() - 1};
         }
@@ -453,6 +518,7 @@ void SectionedResults::calculate_sections()
         }
     }
     m_has_performed_initial_evaluation = true;
+    ++m_calculation_count;
 }
 
 size_t SectionedResults::size()
@@ -487,15 +553,19 @@ ResultsSection SectionedResults::operator[](Mixed key)
 NotificationToken SectionedResults::add_notification_callback(SectionedResultsNotificationCallback&& callback,
                                                               std::optional<KeyPathArray> key_path_array) &
 {
-    return m_results.add_notification_callback(SectionedResultsNotificationHandler(*this, std::move(callback)),
-                                               std::move(key_path_array));
+    bool has_key_path_filter = key_path_array.has_value();
+    return m_results.add_notification_callback(
+        SectionedResultsNotificationHandler(*this, std::move(callback), has_key_path_filter),
+        std::move(key_path_array));
 }
 
 NotificationToken SectionedResults::add_notification_callback_for_section(
     Mixed section_key, SectionedResultsNotificationCallback&& callback, std::optional<KeyPathArray> key_path_array)
 {
+    bool has_key_path_filter = key_path_array.has_value();
     return m_results.add_notification_callback(
-        SectionedResultsNotificationHandler(*this, std::move(callback), section_key), std::move(key_path_array));
+        SectionedResultsNotificationHandler(*this, std::move(callback), has_key_path_filter, section_key),
+        std::move(key_path_array));
 }
 
 // Thread-safety analysis doesn't work when creating a different instance of the
@@ -552,5 +622,6 @@ void SectionedResults::reset_section_callback(SectionKeyFunc section_callback)
     m_current_key_to_index.clear();
     m_previous_key_to_index.clear();
     m_row_to_index_path.clear();
+    m_row_to_key.clear();
 }
 } // namespace realm
@@ -168,9 +168,16 @@ private:
     friend struct SectionedResultsNotificationHandler;
     util::CheckedOptionalMutex m_mutex;
     SectionedResults copy(Results&&) REQUIRES(!m_mutex);
-    void calculate_sections_if_required() REQUIRES(m_mutex);
-    void calculate_sections() REQUIRES(m_mutex);
+    // If `changes` describes the change to the results since the last calculation, only the inserted and
+    // modified rows are passed to the section key callback.
+    void calculate_sections_if_required(CollectionChangeSet const* changes = nullptr) REQUIRES(m_mutex);
+    void calculate_sections(CollectionChangeSet const* changes) REQUIRES(m_mutex);
+    bool update_row_keys(CollectionChangeSet const& changes, size_t size) REQUIRES(m_mutex);
+    Mixed compute_section_key(size_t row) REQUIRES(m_mutex);
     bool m_has_performed_initial_evaluation = false;
+    // Incremented each time the sections are calculated, so that a notification handler can tell if the
+    // change set it was given describes the change since the last calculation.
+    uint64_t m_calculation_count = 0;
     NotificationToken
     add_notification_callback_for_section(Mixed section_key, SectionedResultsNotificationCallback&& callback,
                                           std::optional<KeyPathArray> key_path_array = std::nullopt);
@@ -192,6 +199,9 @@ private:
     // this will give a pair with the section index of the object, and the position of the object in that section.
     // This is used for parsing the indices in CollectionChangeSet to section indices.
     std::vector<std::pair<size_t, size_t>> m_row_to_index_path;
+    // The section key of each object in the underlying `Results`. Keys of rows which were neither inserted nor
+    // modified are reused when the sections are recalculated from a change set.
+    std::vector<Mixed> m_row_to_key;
     // BinaryData & StringData types require a buffer to hold deep
     // copies of the key values for the lifetime of the sectioned results.
     // This is due to the fact that such values can reference the memory address of the value in the realm.
@@ -158,7 +158,10 @@ void Realm::Internal::begin_read(Realm& realm, VersionID version_id)
 void Realm::begin_read(VersionID version_id)
 {
     REALM_ASSERT(!m_transaction);
-    m_transaction = m_coordinator->begin_read(version_id, bool(m_frozen_version));
+    if (m_frozen_version)
+        m_transaction = m_coordinator->begin_shared_frozen_read(version_id);
+    else
+        m_transaction = m_coordinator->begin_read(version_id);
     add_schema_change_handler();
     read_schema_from_group_if_needed();
 }
@@ -568,7 +571,9 @@ void Realm::rename_property(Schema schema, StringData object_type, StringData ol
 
 void Realm::add_schema_change_handler()
 {
-    if (m_config.immutable())
+    // The schema can't change in a frozen transaction, which may also be
+    // shared with other frozen Realms
+    if (m_config.immutable() || m_frozen_version)
         return;
     m_transaction->set_schema_change_notification_handler([&] {
         m_new_schema = ObjectStore::schema_from_group(read_group());
@@ -1128,7 +1133,9 @@ void Realm::invalidate()
 
 void Realm::do_invalidate()
 {
-    if (!m_config.immutable() && m_transaction) {
+    // Frozen transactions may be shared with other frozen Realms, and are
+    // closed when the last reference to them is released
+    if (!m_config.immutable() && !m_frozen_version && m_transaction) {
         m_transaction->prepare_for_close();
         call_completion_callbacks();
         transaction().close();
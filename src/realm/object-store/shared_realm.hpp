@@ -43,6 +43,7 @@ class Replication;
 class StringData;
 class Table;
 class ThreadSafeReference;
+class ThreadSafeReferenceBatch;
 class Transaction;
 class SyncSession;
 struct AuditConfig;
@@ -185,6 +186,12 @@ struct RealmConfig {
     // speeds up tests that don't need notifications.
     bool automatic_change_notifications = true;
 
+    // Maximum number of threads used to run the async notifiers of this file
+    // after each commit. Notifiers are spread over that many read transactions
+    // and the notifiers sharing a transaction are run on the same thread. The
+    // default of 1 runs all notifiers on the notifier thread.
+    size_t max_notifier_threads = 1;
+
     // For internal use and should not be exposed by SDKs.
     //
     // If the file is invalid or can't be decrypted with the given encryption
@@ -473,6 +480,7 @@ public:
         friend class _impl::RealmCoordinator;
         friend class TestHelper;
         friend class ThreadSafeReference;
+        friend class ThreadSafeReferenceBatch;
 
         static Transaction& get_transaction(Realm& realm)
         {
@@ -31,10 +31,87 @@
 #include <realm/db.hpp>
 #include <realm/keys.hpp>
 
+#include <unordered_map>
+#include <variant>
+
 namespace realm {
 
 using OsDict = object_store::Dictionary;
 
+namespace {
+// The parts of a Results needed to recreate it in another Realm. Queries are
+// imported into `transaction`, which pins the source version and is only needed
+// for Results of objects.
+class ResultsHandover {
+public:
+    ResultsHandover(Results const& r, Transaction* transaction)
+        : m_ordering(r.get_descriptor_ordering())
+    {
+        if (r.get_type() != PropertyType::Object) {
+            auto list = r.get_collection();
+            REALM_ASSERT(list);
+            m_key = list->get_owner_key();
+            m_table_key = list->get_table()->get_key();
+            // FIXME: Use path for list when supporting notifications for nested collections
+            m_col_key = list->get_col_key();
+        }
+        else {
+            Query q(r.get_query());
+            REALM_ASSERT(transaction);
+            m_query = transaction->import_copy_of(q, PayloadPolicy::Stay);
+            // If the Query is derived from a collection which was created in
+            // the current write transaction then the collection cannot be
+            // handed over and would just be empty when resolved.
+            if (q.view_owner_obj_key() != m_query->view_owner_obj_key()) {
+                throw WrongTransactionState(
+                    "Cannot create a ThreadSafeReference to Results backed by a collection of objects "
+                    "inside the write transaction which created the collection.");
+            }
+        }
+    }
+
+    Results import_into(std::shared_ptr<Realm> const& r)
+    {
+        if (m_key) {
+            CollectionBasePtr collection;
+            auto table = r->read_group().get_table(m_table_key);
+            try {
+                collection = table->get_object(m_key).get_collection_ptr(m_col_key);
+            }
+            catch (KeyNotFound const&) {
+                // Create a detached list of the appropriate type so that we
+                // return an invalid Results rather than an Empty Results, to
+                // match what happens for other types of handover where the
+                // object doesn't exist.
+                if (m_col_key.is_dictionary()) {
+                    collection = std::make_unique<Dictionary>();
+                }
+                else {
+                    switch_on_type(ObjectSchema::from_core_type(m_col_key), [&](auto* t) -> void {
+                        if (m_col_key.is_list()) {
+                            collection = std::make_unique<Lst<NonObjTypeT<decltype(*t)>>>();
+                        }
+                        else if (m_col_key.is_set()) {
+                            collection = std::make_unique<Set<NonObjTypeT<decltype(*t)>>>();
+                        }
+                    });
+                }
+            }
+            return Results(r, std::move(collection), m_ordering);
+        }
+        auto q = r->import_copy_of(*m_query, PayloadPolicy::Stay);
+        return Results(r, std::move(*q), m_ordering);
+    }
+
+private:
+    DescriptorOrdering m_ordering;
+    std::unique_ptr<Query> m_query;
+    ObjKey m_key;
+    TableKey m_table_key;
+    ColKey m_col_key;
+};
+} // anonymous namespace
+
 class ThreadSafeReference::Payload {
 public:
     virtual ~Payload() = default;
@@ -46,6 +123,12 @@ public:
 
     void refresh_target_realm(Realm&);
 
+    bool is_source_version(Realm& realm) const
+    {
+        return realm.current_transaction_version() == m_source_version &&
+               realm.is_in_transaction() == m_created_in_write_transaction;
+    }
+
 private:
     const util::Optional<VersionID> m_source_version;
     const bool m_created_in_write_transaction;
@@ -145,72 +228,20 @@ public:
     PayloadImpl(Results const& r)
         : Payload(*r.get_realm())
         , m_coordinator(Realm::Internal::get_coordinator(*r.get_realm()).shared_from_this())
-        , m_ordering(r.get_descriptor_ordering())
+        , m_transaction(r.get_type() == PropertyType::Object ? r.get_realm()->duplicate() : nullptr)
+        , m_results(r, m_transaction.get())
     {
-        if (r.get_type() != PropertyType::Object) {
-            auto list = r.get_collection();
-            REALM_ASSERT(list);
-            m_key = list->get_owner_key();
-            m_table_key = list->get_table()->get_key();
-            // FIXME: Use path for list when supporting notifications for nested collections
-            m_col_key = list->get_col_key();
-        }
-        else {
-            Query q(r.get_query());
-            m_transaction = r.get_realm()->duplicate();
-            m_query = m_transaction->import_copy_of(q, PayloadPolicy::Stay);
-            // If the Query is derived from a collection which was created in
-            // the current write transaction then the collection cannot be
-            // handed over and would just be empty when resolved.
-            if (q.view_owner_obj_key() != m_query->view_owner_obj_key()) {
-                throw WrongTransactionState(
-                    "Cannot create a ThreadSafeReference to Results backed by a collection of objects "
-                    "inside the write transaction which created the collection.");
-            }
-        }
     }
 
     Results import_into(std::shared_ptr<Realm> const& r)
     {
-        if (m_key) {
-            CollectionBasePtr collection;
-            auto table = r->read_group().get_table(m_table_key);
-            try {
-                collection = table->get_object(m_key).get_collection_ptr(m_col_key);
-            }
-            catch (KeyNotFound const&) {
-                // Create a detached list of the appropriate type so that we
-                // return an invalid Results rather than an Empty Results, to
-                // match what happens for other types of handover where the
-                // object doesn't exist.
-                if (m_col_key.is_dictionary()) {
-                    collection = std::make_unique<Dictionary>();
-                }
-                else {
-                    switch_on_type(ObjectSchema::from_core_type(m_col_key), [&](auto* t) -> void {
-                        if (m_col_key.is_list()) {
-                            collection = std::make_unique<Lst<NonObjTypeT<decltype(*t)>>>();
-                        }
-                        else if (m_col_key.is_set()) {
-                            collection = std::make_unique<Set<NonObjTypeT<decltype(*t)>>>();
-                        }
-                    });
-                }
-            }
-            return Results(r, std::move(collection), m_ordering);
-        }
-        auto q = r->import_copy_of(*m_query, PayloadPolicy::Stay);
-        return Results(std::move(r), std::move(*q), m_ordering);
+        return m_results.import_into(r);
     }
 
 private:
     const std::shared_ptr<_impl::RealmCoordinator> m_coordinator;
     TransactionRef m_transaction;
-    DescriptorOrdering m_ordering;
-    std::unique_ptr<Query> m_query;
-    ObjKey m_key;
-    TableKey m_table_key;
-    ColKey m_col_key;
+    ResultsHandover m_results;
 };
 
 template <>
@@ -305,4 +336,246 @@ template bool ThreadSafeReference::is<object_store::Set>() const;
 template bool ThreadSafeReference::is<OsDict>() const;
 template bool ThreadSafeReference::is<Object>() const;
 
+class ThreadSafeReferenceBatch::Impl : public ThreadSafeReference::Payload {
+public:
+    Impl(Realm& realm)
+        : Payload(realm)
+        , m_coordinator(Realm::Internal::get_coordinator(realm).shared_from_this())
+    {
+    }
+
+    void verify_source(Realm& realm) const
+    {
+        realm.verify_thread();
+        if (&Realm::Internal::get_coordinator(realm) != m_coordinator.get() || !is_source_version(realm)) {
+            throw WrongTransactionState(
+                "All values in a ThreadSafeReferenceBatch must come from the same Realm at the same version.");
+        }
+    }
+
+    size_t add(Object const& object)
+    {
+        auto& obj = object.get_obj();
+        return add_entry(Type::Object, obj.get_table()->get_key(), obj.get_key());
+    }
+
+    template <typename Collection>
+    size_t add(Collection const& collection)
+    {
+        return add_entry(type_of(collection), collection.get_parent_table_key(),
+                         collection.get_parent_object_key(), collection.get_parent_column_key());
+    }
+
+    size_t add(Results const& results)
+    {
+        // All of the queries are imported into one transaction, which is the
+        // only thing pinning the source version
+        if (!m_transaction && results.get_type() == PropertyType::Object)
+            m_transaction = results.get_realm()->duplicate();
+        m_results.emplace_back(results, m_transaction.get());
+        return add_entry(Type::Results, {}, {}, {}, m_results.size() - 1);
+    }
+
+    size_t size() const noexcept
+    {
+        return m_entries.size();
+    }
+
+    void resolve(std::shared_ptr<Realm> const& realm)
+    {
+        realm->verify_thread();
+        refresh_target_realm(*realm);
+
+        struct TableInfo {
+            TableRef table;
+            ObjectSchema const* object_schema = nullptr;
+        };
+        std::unordered_map<TableKey, TableInfo> tables;
+        auto& group = realm->read_group();
+        auto get_table = [&](TableKey table_key) -> TableInfo& {
+            auto& info = tables[table_key];
+            if (!info.table)
+                info.table = group.get_table(table_key);
+            return info;
+        };
+
+        // Resolve into a local vector so that a throw part way through leaves
+        // the values from the previous call to resolve() intact
+        std::vector<Value> resolved;
+        resolved.reserve(m_entries.size());
+        for (auto& entry : m_entries) {
+            if (entry.type == Type::Results) {
+                resolved.push_back(m_results[entry.results_index].import_into(realm));
+                continue;
+            }
+            try {
+                auto& info = get_table(entry.table_key);
+                Obj obj = info.table->get_object(entry.obj_key);
+                switch (entry.type) {
+                    case Type::Object:
+                        if (!info.object_schema) {
+                            auto it = realm->schema().find(entry.table_key);
+                            if (it == realm->schema().end()) {
+                                throw InvalidArgument(
+                                    ErrorCodes::NoSuchTable,
+                                    util::format("Cannot resolve a ThreadSafeReferenceBatch containing an object of "
+                                                 "type '%1' in a Realm whose schema does not include it.",
+                                                 info.table->get_class_name()));
+                            }
+                            info.object_schema = &*it;
+                        }
+                        resolved.push_back(Object(realm, *info.object_schema, obj));
+                        break;
+                    case Type::List:
+                        resolved.push_back(List(realm, obj, entry.col_key));
+                        break;
+                    case Type::Set:
+                        resolved.push_back(object_store::Set(realm, obj, entry.col_key));
+                        break;
+                    case Type::Dictionary:
+                        resolved.push_back(OsDict(realm, obj, entry.col_key));
+                        break;
+                    case Type::Results:
+                        REALM_UNREACHABLE();
+                }
+            }
+            catch (KeyNotFound const&) {
+                // Object was deleted in a version after when the batch was created
+                resolved.push_back(empty_value(entry.type));
+            }
+        }
+        m_resolved = std::move(resolved);
+    }
+
+    template <typename T>
+    T get(size_t index) const
+    {
+        if (index >= m_resolved.size())
+            throw OutOfBounds("ThreadSafeReferenceBatch::get()", index, m_resolved.size());
+        auto value = std::get_if<T>(&m_resolved[index]);
+        if (!value) {
+            throw InvalidArgument(util::format("ThreadSafeReferenceBatch value at index %1 is of type %2, not %3.",
+                                               index, name_of(m_resolved[index].index()), name_of(index_of<T>())));
+        }
+        return *value;
+    }
+
+private:
+    enum class Type { Object, Results, List, Set, Dictionary };
+    using Value = std::variant<Object, Results, List, object_store::Set, OsDict>;
+
+    struct Entry {
+        Type type;
+        TableKey table_key;
+        ObjKey obj_key;
+        ColKey col_key;
+        size_t results_index;
+    };
+
+    const std::shared_ptr<_impl::RealmCoordinator> m_coordinator;
+    TransactionRef m_transaction;
+    std::vector<Entry> m_entries;
+    std::vector<ResultsHandover> m_results;
+    std::vector<Value> m_resolved;
+
+    size_t add_entry(Type type, TableKey table_key, ObjKey obj_key, ColKey col_key = {}, size_t results_index = 0)
+    {
+        m_entries.push_back({type, table_key, obj_key, col_key, results_index});
+        return m_entries.size() - 1;
+    }
+
+    static Type type_of(List const&)
+    {
+        return Type::List;
+    }
+    static Type type_of(object_store::Set const&)
+    {
+        return Type::Set;
+    }
+    static Type type_of(OsDict const&)
+    {
+        return Type::Dictionary;
+    }
+
+    static const char* name_of(size_t variant_index)
+    {
+        static constexpr const char* names[std::variant_size_v<Value>] = {"Object", "Results", "List", "Set",
+                                                                          "Dictionary"};
+        return names[variant_index];
+    }
+
+    template <typename T, size_t I = 0>
+    static constexpr size_t index_of()
+    {
+        if constexpr (std::is_same_v<T, std::variant_alternative_t<I, Value>>)
+            return I;
+        else
+            return index_of<T, I + 1>();
+    }
+
+    static Value empty_value(Type type)
+    {
+        switch (type) {
+            case Type::Object:
+                return Object();
+            case Type::List:
+                return List();
+            case Type::Set:
+                return object_store::Set();
+            case Type::Dictionary:
+                return OsDict();
+            case Type::Results:
+                break;
+        }
+        REALM_UNREACHABLE();
+    }
+};
+
+ThreadSafeReferenceBatch::ThreadSafeReferenceBatch() noexcept = default;
+ThreadSafeReferenceBatch::~ThreadSafeReferenceBatch() = default;
+ThreadSafeReferenceBatch::ThreadSafeReferenceBatch(ThreadSafeReferenceBatch&&) noexcept = default;
+ThreadSafeReferenceBatch& ThreadSafeReferenceBatch::operator=(ThreadSafeReferenceBatch&&) noexcept = default;
+
+template <typename T>
+size_t ThreadSafeReferenceBatch::add(T const& value)
+{
+    auto& realm = *value.get_realm();
+    if (!m_impl)
+        m_impl = std::make_unique<Impl>(realm);
+    m_impl->verify_source(realm);
+    return m_impl->add(value);
+}
+
+size_t ThreadSafeReferenceBatch::size() const noexcept
+{
+    return m_impl ? m_impl->size() : 0;
+}
+
+void ThreadSafeReferenceBatch::resolve(std::shared_ptr<Realm> const& realm)
+{
+    REALM_ASSERT(realm);
+    if (m_impl)
+        m_impl->resolve(realm);
+}
+
+template <typename T>
+T ThreadSafeReferenceBatch::get(size_t index) const
+{
+    if (!m_impl)
+        throw OutOfBounds("ThreadSafeReferenceBatch::get()", index, 0);
+    return m_impl->get<T>(index);
+}
+
+template size_t ThreadSafeReferenceBatch::add(Object const&);
+template size_t ThreadSafeReferenceBatch::add(Results const&);
+template size_t ThreadSafeReferenceBatch::add(List const&);
+template size_t ThreadSafeReferenceBatch::add(object_store::Set const&);
+template size_t ThreadSafeReferenceBatch::add(OsDict const&);
+
+template Object ThreadSafeReferenceBatch::get(size_t) const;
+template Results ThreadSafeReferenceBatch::get(size_t) const;
+template List ThreadSafeReferenceBatch::get(size_t) const;
+template object_store::Set ThreadSafeReferenceBatch::get(size_t) const;
+template OsDict ThreadSafeReferenceBatch::get(size_t) const;
+
 } // namespace realm
@@ -26,6 +26,7 @@ class List;
 class Object;
 class Realm;
 class Results;
+class ThreadSafeReferenceBatch;
 namespace object_store {
 class Dictionary;
 }
@@ -57,6 +58,7 @@ public:
     }
 
 private:
+    friend class ThreadSafeReferenceBatch;
     class Payload;
     template <typename>
     class CollectionPayload;
@@ -69,6 +71,44 @@ template <>
 ThreadSafeReference::ThreadSafeReference(std::shared_ptr<Realm> const&);
 template <>
 std::shared_ptr<Realm> ThreadSafeReference::resolve(std::shared_ptr<Realm> const&);
+
+// A group of references to objects, collections and Results from a single
+// version of a Realm which are imported into another Realm together. The Results
+// in the batch share a single pin on the source version, and resolving the batch
+// refreshes the destination Realm and looks up each table once rather than once
+// per value.
+class ThreadSafeReferenceBatch {
+public:
+    ThreadSafeReferenceBatch() noexcept;
+    ~ThreadSafeReferenceBatch();
+    ThreadSafeReferenceBatch(const ThreadSafeReferenceBatch&) = delete;
+    ThreadSafeReferenceBatch& operator=(const ThreadSafeReferenceBatch&) = delete;
+    ThreadSafeReferenceBatch(ThreadSafeReferenceBatch&&) noexcept;
+    ThreadSafeReferenceBatch& operator=(ThreadSafeReferenceBatch&&) noexcept;
+
+    // Add a value to the batch and return its index. All of the values in a
+    // batch must come from the same Realm at the same version.
+    template <typename T>
+    size_t add(T const& value);
+
+    size_t size() const noexcept;
+
+    // Import every value in the batch into the destination Realm. Values which
+    // no longer exist at the destination's version are resolved to invalid
+    // accessors, as with ThreadSafeReference::resolve(). Throws if the batch
+    // contains an object whose type is not in the destination Realm's schema.
+    void resolve(std::shared_ptr<Realm> const&);
+
+    // Get a value imported by the last call to resolve(), using the index
+    // returned by add(). Throws if the index is out of range or the value at
+    // that index is not a T.
+    template <typename T>
+    T get(size_t index) const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> m_impl;
+};
 } // namespace realm
 
 #endif /* REALM_OS_THREAD_SAFE_REFERENCE_HPP */
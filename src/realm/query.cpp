@@ -1100,6 +1100,18 @@ bool Query::eval_object(const Obj& obj) const
     return true;
 }
 
+std::vector<ObjKey> Query::eval_objects(const std::vector<ObjKey>& keys) const
+{
+    init();
+    std::vector<ObjKey> ret;
+    auto table = m_table.unchecked_ptr();
+    for (auto key : keys) {
+        if (Obj obj = table->try_get_object(key); obj && eval_object(obj))
+            ret.push_back(key);
+    }
+    return ret;
+}
+
 
 template <typename T>
 void Query::aggregate(QueryStateBase& st, ColKey column_key) const
@@ -2033,6 +2045,14 @@ void Query::get_outside_versions(TableVersions& versions) const
     }
 }
 
+bool Query::follows_links() const
+{
+    std::vector<TableKey> tables;
+    if (ParentNode* root = root_node())
+        root->get_link_dependencies(tables);
+    return !tables.empty();
+}
+
 TableVersions Query::sync_view_if_needed() const
 {
     if (m_view) {
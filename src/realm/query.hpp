@@ -299,6 +299,10 @@ public:
         return m_groups.size() > 0 && m_groups[0].m_root_node;
     }
     void get_outside_versions(TableVersions&) const;
+    // True if any condition follows a link or backlink, even if the link
+    // target is the queried table itself. Whether an object matches such a
+    // query can change without that object being modified.
+    bool follows_links() const;
 
     // True if matching rows are guaranteed to be returned in table order.
     bool produces_results_in_table_order() const
@@ -328,6 +332,9 @@ public:
     util::bind_ptr<DescriptorOrdering> get_ordering();
 
     bool eval_object(const Obj& obj) const;
+    // Return the keys of the objects in 'keys' which match the query, in the
+    // same order. Keys of objects which no longer exist are skipped.
+    std::vector<ObjKey> eval_objects(const std::vector<ObjKey>& keys) const;
 
 private:
     void create();
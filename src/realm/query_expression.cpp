@@ -50,6 +50,10 @@ void LinkMap::set_base_table(ConstTableRef table)
 
 void LinkMap::collect_dependencies(std::vector<TableKey>& tables) const
 {
+    // A path without links only reads the base table, which is not a
+    // dependency of its own
+    if (!has_links())
+        return;
     for (auto& t : m_tables) {
         TableKey k = t->get_key();
         if (find(tables.begin(), tables.end(), k) == tables.end()) {
@@ -231,6 +235,8 @@ std::vector<ObjKey> LinkMap::get_origin_objkeys(ObjKey key, size_t column) const
     auto origin_col = m_link_column_keys[column];
     auto origin = m_tables[column];
     auto link_type = m_link_types[column];
+    // The link column may have been removed since the query was built
+    origin->check_column(origin_col);
     if (link_type == col_type_BackLink) {
         auto link_table = origin->get_opposite_table(origin_col);
         ColKey link_col_key = origin->get_opposite_column(origin_col);
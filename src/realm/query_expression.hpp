@@ -250,10 +250,6 @@ public:
     {
         m_first[0] = init_val;
     }
-    ~ValueBase()
-    {
-        dealloc();
-    }
     ValueBase(const ValueBase& other)
     {
         *this = other;
@@ -278,6 +274,14 @@ public:
         resize(nb_values);
     }
 
+    // Bring a reused value back to the state of a default constructed one, which is what
+    // Subexpr::evaluate() expects of its destination. Allocated storage is kept.
+    void reset()
+    {
+        init(false, 1);
+        set_null(0);
+    }
+
     void init_for_links(bool only_unary_links, size_t size)
     {
         if (only_unary_links) {
@@ -418,6 +422,22 @@ public:
         }
     }
 
+    // Compares values row by row when neither side comes from a list, and returns a bit mask
+    // with bit i set if row i matched
+    template <class TCond>
+    REALM_FORCEINLINE static uint64_t compare_rows(const ValueBase& left, const ValueBase& right)
+    {
+        static_assert(chunk_size <= 64);
+        REALM_ASSERT_DEBUG(!left.m_from_list && !right.m_from_list);
+        TCond c;
+        uint64_t matches = 0;
+        size_t min = minimum(left.size(), right.size());
+        for (size_t m = 0; m < min; m++) {
+            matches |= uint64_t(c(left[m], right[m])) << m;
+        }
+        return matches;
+    }
+
     // Given a TCond (==, !=, >, <, >=, <=) and two Value<T>, return index of first match
     template <class TCond>
     REALM_FORCEINLINE static size_t compare(ValueBase& left, ValueBase& right,
@@ -606,33 +626,32 @@ public:
 private:
     // If true, all values in the class come from a link list of a single field in the parent table (m_table). If
     // false, then values come from successive rows of m_table (query operations are operated on in bulks for speed)
-    static constexpr size_t prealloc = 8;
+    static constexpr size_t prealloc = chunk_size;
 
     QueryValue m_cache[prealloc];
     QueryValue* m_first = &m_cache[0];
     size_t m_size = 1;
     bool m_sorted = false;
+    // Heap storage for more than 'prealloc' values. It is kept when the value shrinks, so
+    // that a ValueBase used as a scratch buffer only allocates when it grows.
+    std::unique_ptr<QueryValue[]> m_heap;
+    size_t m_capacity = 0;
 
     void resize(size_t size)
     {
         if (size == m_size)
             return;
 
-        dealloc();
         m_size = size;
-        if (m_size > 0) {
-            if (m_size > prealloc)
-                m_first = new QueryValue[m_size];
-            else
-                m_first = &m_cache[0];
+        if (m_size > prealloc) {
+            if (m_size > m_capacity) {
+                m_heap = std::make_unique<QueryValue[]>(m_size);
+                m_capacity = m_size;
+            }
+            m_first = m_heap.get();
         }
-    }
-    void dealloc()
-    {
-        if (m_first) {
-            if (m_size > prealloc)
-                delete[] m_first;
-            m_first = nullptr;
+        else {
+            m_first = &m_cache[0];
         }
     }
     void fill(const QueryValue& val)
@@ -4368,23 +4387,25 @@ public:
     // destination = operator(left, right)
     void evaluate(Subexpr::Index& index, ValueBase& destination) override
     {
-        Value<T> result;
-        Value<T> left;
-        Value<T> right;
+        // The operands are evaluated into buffers owned by this operator, which are reused
+        // across calls, and the result is written straight into the destination
         if (m_left_is_const) {
-            m_right->evaluate(index, right);
-            result.template fun_const<oper>(m_const_value, right);
+            m_right_buf.reset();
+            m_right->evaluate(index, m_right_buf);
+            destination.template fun_const<oper>(m_const_value, m_right_buf);
         }
         else if (m_right_is_const) {
-            m_left->evaluate(index, left);
-            result.template fun_const<oper>(left, m_const_value);
+            m_left_buf.reset();
+            m_left->evaluate(index, m_left_buf);
+            destination.template fun_const<oper>(m_left_buf, m_const_value);
         }
         else {
-            m_left->evaluate(index, left);
-            m_right->evaluate(index, right);
-            result.template fun<oper>(left, right);
+            m_left_buf.reset();
+            m_right_buf.reset();
+            m_left->evaluate(index, m_left_buf);
+            m_right->evaluate(index, m_right_buf);
+            destination.template fun<oper>(m_left_buf, m_right_buf);
         }
-        destination = result;
     }
 
     std::string description(util::serializer::SerialisationState& state) const override
@@ -4423,6 +4444,8 @@ private:
     bool m_left_is_const;
     bool m_right_is_const;
     Mixed m_const_value;
+    ValueBase m_left_buf;
+    ValueBase m_right_buf;
 };
 
 class CompareBase : public Expression {
@@ -4456,6 +4479,7 @@ public:
             m_left->set_cluster(cluster);
             m_right->set_cluster(cluster);
         }
+        m_chunk_start = m_chunk_end = 0;
     }
 
     // Recursively fetch tables of columns in expression tree. Used when user first builds a stand-alone expression
@@ -4540,6 +4564,16 @@ protected:
     std::vector<ObjKey> m_matches;
     mutable size_t m_index_get = 0;
     size_t m_index_end = 0;
+
+    // Scratch buffers for evaluating the operands
+    mutable ValueBase m_left_buf;
+    mutable ValueBase m_right_buf;
+    // Rows [m_chunk_start, m_chunk_end) of the current cluster were evaluated by the previous
+    // call to find_first(), and bit i of m_chunk_matches is set if row m_chunk_start + i matched.
+    // Following calls for rows in that range are answered from the mask.
+    mutable size_t m_chunk_start = 0;
+    mutable size_t m_chunk_end = 0;
+    mutable uint64_t m_chunk_matches = 0;
 };
 
 template <class TCond>
@@ -4550,6 +4584,8 @@ public:
     double init() override
     {
         double dT = 50.0;
+        m_has_matches = false;
+        m_chunk_start = m_chunk_end = 0;
         if ((m_left->has_single_value()) || (m_right->has_single_value())) {
             dT = 10.0;
             if constexpr (std::is_same_v<TCond, Equal>) {
@@ -4603,6 +4639,9 @@ public:
                     dT = 0;
                 }
             }
+            if (!m_has_matches && init_semi_join()) {
+                dT = 0;
+            }
         }
 
         return dT;
@@ -4615,33 +4654,57 @@ public:
         }
 
         size_t match;
-        ValueBase left_buf;
-        ValueBase right_buf;
         const util::Optional<ExpressionComparisonType> left_cmp_type = m_left->get_comparison_type();
         const util::Optional<ExpressionComparisonType> right_cmp_type = m_right->get_comparison_type();
 
-        ValueBase* left = m_left_const_values ? m_left_const_values : &left_buf;
-        ValueBase* right = m_right_const_values ? m_right_const_values : &right_buf;
+        ValueBase* left = m_left_const_values ? m_left_const_values : &m_left_buf;
+        ValueBase* right = m_right_const_values ? m_right_const_values : &m_right_buf;
 
         for (; start < end;) {
+            if (start >= m_chunk_start && start < m_chunk_end) {
+                uint64_t matches = m_chunk_matches >> (start - m_chunk_start);
+                if (matches) {
+                    match = start + size_t(ctz(matches));
+                    return match < end ? match : not_found;
+                }
+                start = m_chunk_end;
+                continue;
+            }
+
             // In case of wildcard query strings, we will get a value for every collection matching the path
             // We need to match those separately against the other value - which might also come in multiple
             // instances.
+            bool chunk_evaluated = false;
             Subexpr::Index right_index(start);
             do {
                 Subexpr::Index left_index(start);
                 if (!m_right_const_values) {
-                    m_right->evaluate(right_index, right_buf);
+                    m_right_buf.reset();
+                    m_right->evaluate(right_index, m_right_buf);
                 }
                 do {
-                    if (!m_left_const_values)
-                        m_left->evaluate(left_index, left_buf);
+                    if (!m_left_const_values) {
+                        m_left_buf.reset();
+                        m_left->evaluate(left_index, m_left_buf);
+                    }
+                    if (!left->m_from_list && !right->m_from_list && !left_index.more() && !right_index.more()) {
+                        // One value per row on both sides. Compare all rows of the chunk at once and
+                        // keep the result for the next calls.
+                        m_chunk_matches = ValueBase::template compare_rows<TCond>(*left, *right);
+                        m_chunk_start = start;
+                        m_chunk_end = start + std::min(right->size(), left->size());
+                        chunk_evaluated = m_chunk_end > start;
+                        break;
+                    }
                     match = ValueBase::template compare<TCond>(*left, *right, left_cmp_type, right_cmp_type);
                     if (match != not_found && match + start < end)
                         return start + match;
                 } while (left_index.more());
             } while (right_index.more());
 
+            if (chunk_evaluated)
+                continue;
+
             size_t rows = (left->m_from_list || right->m_from_list) ? 1 : std::min(right->size(), left->size());
             start += rows;
         }
@@ -4671,6 +4734,90 @@ public:
     {
         return std::unique_ptr<Expression>(new Compare(*this));
     }
+
+private:
+    // A comparison between a constant and a property reached through links is normally
+    // evaluated by following the links from every object in the base table. When the
+    // target table is no larger than the base table, it can be cheaper to evaluate the
+    // condition on the target table and map the matching target objects back to the base
+    // table through their backlinks. The scan of the target table is abandoned, and the
+    // links followed as usual, if too many target objects match for this to pay off.
+    // A small sample of the target table is checked first, so that conditions that
+    // are not selective are rejected without scanning the whole target table.
+    static constexpr size_t s_semi_join_sample_size = 64;
+
+    bool init_semi_join()
+    {
+        const bool const_on_left = m_left->has_single_value();
+        Subexpr* column = const_on_left ? m_right.get() : m_left.get();
+        const Subexpr* constant = const_on_left ? m_left.get() : m_right.get();
+        auto prop = dynamic_cast<const ObjPropertyBase*>(column);
+        if (!prop || !prop->links_exist() || column->has_indexes_in_link_map())
+            return false;
+
+        // ALL and NONE need to see every linked value
+        if (column->get_comparison_type().value_or(ExpressionComparisonType::Any) != ExpressionComparisonType::Any ||
+            constant->get_comparison_type().value_or(ExpressionComparisonType::Any) ==
+                ExpressionComparisonType::None)
+            return false;
+
+        ColKey col_key = prop->column_key();
+        auto col_type = col_key.get_type();
+        if (col_key.is_collection() || col_type == col_type_Mixed || col_type == col_type_Link ||
+            col_type == col_type_TypedLink || col_type == col_type_BackLink)
+            return false;
+
+        TCond cond;
+        QueryValue const_value(constant->get_mixed());
+        auto matches = [&](const QueryValue& v) {
+            return const_on_left ? cond(const_value, v) : cond(v, const_value);
+        };
+        // Objects with a null link are compared against null, and would be missed when
+        // starting from the target table
+        if (matches(QueryValue()))
+            return false;
+
+        const LinkMap& link_map = prop->get_link_map();
+        auto target = link_map.get_target_table();
+        size_t base_size = link_map.get_base_table()->size();
+        if (target->size() > base_size)
+            return false;
+
+        const size_t max_target_matches = base_size / 4;
+        const size_t target_size = target->size();
+        if (target_size > s_semi_join_sample_size) {
+            size_t sample_matches = 0;
+            for (size_t i = 0; i < s_semi_join_sample_size; ++i) {
+                Obj obj = target->get_object(i * target_size / s_semi_join_sample_size);
+                if (matches(QueryValue(obj.get_any(col_key))))
+                    ++sample_matches;
+            }
+            if (sample_matches * target_size / s_semi_join_sample_size > max_target_matches)
+                return false;
+        }
+
+        std::vector<ObjKey> target_matches;
+        for (auto obj : *target) {
+            if (matches(QueryValue(obj.get_any(col_key)))) {
+                if (target_matches.size() == max_target_matches)
+                    return false;
+                target_matches.push_back(obj.get_key());
+            }
+        }
+
+        m_matches.clear();
+        for (ObjKey k : target_matches) {
+            auto origin_keys = link_map.get_origin_objkeys(k);
+            m_matches.insert(m_matches.end(), origin_keys.begin(), origin_keys.end());
+        }
+        std::sort(m_matches.begin(), m_matches.end());
+        m_matches.erase(std::unique(m_matches.begin(), m_matches.end()), m_matches.end());
+
+        m_has_matches = true;
+        m_index_get = 0;
+        m_index_end = m_matches.size();
+        return true;
+    }
 };
 } // namespace realm
 #endif // REALM_QUERY_EXPRESSION_HPP
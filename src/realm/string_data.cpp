@@ -18,8 +18,14 @@
 
 #include "string_data.hpp"
 
+#include <realm/utilities.hpp>
+
 #include <vector>
 
+#ifdef REALM_COMPILER_SSE
+#include <emmintrin.h> // SSE2
+#endif
+
 using namespace realm;
 
 namespace {
@@ -363,3 +369,46 @@ uint_least64_t realm::cityhash_64(const unsigned char* data, size_t len) noexcep
 {
     return CityHash64{}(data, len);
 }
+
+size_t realm::_impl::search_first_last(StringData haystack, size_t needle_size, const char (&first)[2],
+                                       const char (&last)[2], util::FunctionRef<bool(size_t)> verify)
+{
+    REALM_ASSERT_DEBUG(needle_size > 0);
+    if (needle_size > haystack.size())
+        return haystack.size();
+
+    const char* data = haystack.data();
+    // Number of positions the needle can start at
+    const size_t num_positions = haystack.size() - needle_size + 1;
+    const size_t last_offset = needle_size - 1;
+    size_t i = 0;
+
+#ifdef REALM_COMPILER_SSE
+    // SSE2 is part of the x86-64 baseline, so no runtime check is needed
+    const __m128i first_a = _mm_set1_epi8(first[0]);
+    const __m128i first_b = _mm_set1_epi8(first[1]);
+    const __m128i last_a = _mm_set1_epi8(last[0]);
+    const __m128i last_b = _mm_set1_epi8(last[1]);
+    for (; i + 16 <= num_positions; i += 16) {
+        __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + last_offset));
+        __m128i head_eq = _mm_or_si128(_mm_cmpeq_epi8(head, first_a), _mm_cmpeq_epi8(head, first_b));
+        __m128i tail_eq = _mm_or_si128(_mm_cmpeq_epi8(tail, last_a), _mm_cmpeq_epi8(tail, last_b));
+        size_t mask = size_t(_mm_movemask_epi8(_mm_and_si128(head_eq, tail_eq)));
+        while (mask) {
+            size_t pos = i + size_t(ctz(mask));
+            if (verify(pos))
+                return pos;
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    for (; i < num_positions; ++i) {
+        char c = data[i];
+        char d = data[i + last_offset];
+        if ((c == first[0] || c == first[1]) && (d == last[0] || d == last[1]) && verify(i))
+            return i;
+    }
+    return haystack.size();
+}
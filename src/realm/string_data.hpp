@@ -21,6 +21,7 @@
 
 #include <realm/null.hpp>
 #include <realm/util/features.h>
+#include <realm/util/function_ref.hpp>
 #include <realm/util/optional.hpp>
 
 #include <algorithm>
@@ -42,6 +43,20 @@ size_t murmur2_or_cityhash(const unsigned char* data, size_t len) noexcept;
 uint_least32_t murmur2_32(const unsigned char* data, size_t len) noexcept;
 uint_least64_t cityhash_64(const unsigned char* data, size_t len) noexcept;
 
+namespace _impl {
+/// Finds the first position in \a haystack where a needle of \a needle_size bytes
+/// matches, as decided by \a verify. Only positions where the first byte of the
+/// window equals \a first[0] or \a first[1] and the last byte equals \a last[0] or
+/// \a last[1] are passed to \a verify. On x86 such positions are located 16 at a
+/// time with SSE2. Returns haystack.size() if there is no match.
+size_t search_first_last(StringData haystack, size_t needle_size, const char (&first)[2], const char (&last)[2],
+                         util::FunctionRef<bool(size_t)> verify);
+
+/// Needles up to this size are searched for with search_first_last() rather than
+/// Boyer-Moore. Longer needles give Boyer-Moore skips that outrun the vector scan.
+constexpr size_t s_first_last_max_needle_size = 16;
+} // namespace _impl
+
 
 /// A reference to a chunk of character data.
 ///
@@ -325,6 +340,14 @@ inline bool StringData::contains(StringData d, const std::array<uint8_t, 256>& c
     size_t last_char_pos = d.size() - 1;
     unsigned char lastChar = d[last_char_pos];
 
+    if (needle_size <= _impl::s_first_last_max_needle_size && m_size >= needle_size + 16) {
+        const char first[2] = {d[0], d[0]};
+        const char last[2] = {d[last_char_pos], d[last_char_pos]};
+        return _impl::search_first_last(*this, needle_size, first, last, [&](size_t pos) {
+            return std::memcmp(m_data + pos + 1, d.m_data + 1, needle_size - 1) == 0;
+        }) != m_size;
+    }
+
     // Do Boyer-Moore search
     size_t p = last_char_pos;
     while (p < m_size) {
@@ -15,6 +15,7 @@ InternString Changeset::intern_string(StringData str)
     if (InternString interned = find_string(str))
         return interned;
 
+    unshare_strings(); // Throws
     REALM_ASSERT(m_string_buffer.size() < std::numeric_limits<uint32_t>::max());
     REALM_ASSERT(m_strings.size() < std::numeric_limits<uint32_t>::max());
     REALM_ASSERT(str.size() < std::numeric_limits<uint32_t>::max());
@@ -32,10 +33,12 @@ InternString Changeset::intern_string(StringData str)
 InternString Changeset::find_string(StringData string) const noexcept
 {
     // FIXME: Linear search can be very expensive as changesets can be very big
-    std::size_t n = m_strings.size();
+    const InternStrings& strings = interned_strings();
+    const std::string& buffer = string_buffer();
+    std::size_t n = strings.size();
     for (std::size_t i = 0; i < n; ++i) {
-        const auto& range = m_strings[i];
-        StringData string_2{m_string_buffer.data() + range.offset, range.size};
+        const auto& range = strings[i];
+        StringData string_2{buffer.data() + range.offset, range.size};
         if (string_2 == string)
             return InternString{std::uint_least32_t(i)};
     }
@@ -58,7 +61,7 @@ PrimaryKey Changeset::get_key(const Instruction::PrimaryKey& key) const noexcept
 bool Changeset::operator==(const Changeset& that) const noexcept
 {
     if (m_instructions == that.m_instructions) {
-        return m_strings == that.m_strings;
+        return interned_strings() == that.interned_strings();
     }
     return false;
 }
@@ -184,10 +187,11 @@ void Changeset::print(std::ostream& os) const
 {
     Changeset::Printer printer{os};
     Changeset::Reflector reflector{printer, *this};
+    const InternStrings& strings = interned_strings();
     os << std::left << std::setw(16) << "InternStrings";
-    for (size_t i = 0; i < m_strings.size(); ++i) {
-        os << i << "=\"" << get_string(m_strings.at(i)) << '"';
-        if (i + 1 != m_strings.size())
+    for (size_t i = 0; i < strings.size(); ++i) {
+        os << i << "=\"" << get_string(strings.at(i)) << '"';
+        if (i + 1 != strings.size())
             os << ", ";
     }
     os << "\n";
@@ -203,15 +207,17 @@ void Changeset::print() const
 
 void Changeset::verify() const
 {
-    for (size_t i = 0; i < m_strings.size(); ++i) {
-        auto& range = m_strings.at(i);
-        REALM_ASSERT(range.offset <= m_string_buffer.size());
-        REALM_ASSERT(range.offset + range.size <= m_string_buffer.size());
+    const InternStrings& strings = interned_strings();
+    const std::string& buffer = string_buffer();
+    for (size_t i = 0; i < strings.size(); ++i) {
+        auto& range = strings.at(i);
+        REALM_ASSERT(range.offset <= buffer.size());
+        REALM_ASSERT(range.offset + range.size <= buffer.size());
     }
 
     auto verify_string_range = [&](StringBufferRange range) {
-        REALM_ASSERT(range.offset <= m_string_buffer.size());
-        REALM_ASSERT(range.offset + range.size <= m_string_buffer.size());
+        REALM_ASSERT(range.offset <= buffer.size());
+        REALM_ASSERT(range.offset + range.size <= buffer.size());
     };
 
     auto verify_intern_string = [&](InternString str) {
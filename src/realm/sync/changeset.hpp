@@ -29,10 +29,19 @@ struct Changeset {
     InternString find_string(StringData) const noexcept; // Slow!
     StringData string_data() const noexcept;
 
-    std::string& string_buffer() noexcept;
+    std::string& string_buffer();
     const std::string& string_buffer() const noexcept;
     const InternStrings& interned_strings() const noexcept;
-    InternStrings& interned_strings() noexcept;
+    InternStrings& interned_strings();
+
+    /// Read the interned strings and the string buffer of \a source instead
+    /// of a private copy, until either of them is modified through this
+    /// changeset, at which point they are copied. \a source must outlive this
+    /// changeset, or the sharing must end before it is destroyed or modified.
+    void share_strings(const Changeset& source) noexcept;
+
+    /// Whether the strings are currently read from another changeset.
+    bool shares_strings() const noexcept;
 
     StringBufferRange get_intern_string(InternString) const noexcept;
     util::Optional<StringBufferRange> try_get_intern_string(InternString) const noexcept;
@@ -194,8 +203,11 @@ private:
     std::vector<Instruction> m_instructions;
     std::string m_string_buffer;
     InternStrings m_strings;
+    const Changeset* m_string_owner = nullptr;
     bool m_is_dirty = false;
 
+    const Changeset& string_owner() const noexcept;
+    void unshare_strings();
     iterator const_iterator_to_iterator(const_iterator);
 };
 
@@ -468,44 +480,73 @@ inline void Changeset::clear() noexcept
 
 inline util::Optional<StringBufferRange> Changeset::try_get_intern_string(InternString string) const noexcept
 {
-    if (string.value >= m_strings.size())
+    const InternStrings& strings = interned_strings();
+    if (string.value >= strings.size())
         return util::none;
-    return m_strings[string.value];
+    return strings[string.value];
 }
 
 inline StringBufferRange Changeset::get_intern_string(InternString string) const noexcept
 {
-    REALM_ASSERT(string.value < m_strings.size());
-    return m_strings[string.value];
+    const InternStrings& strings = interned_strings();
+    REALM_ASSERT(string.value < strings.size());
+    return strings[string.value];
 }
 
-inline InternStrings& Changeset::interned_strings() noexcept
+inline InternStrings& Changeset::interned_strings()
 {
+    unshare_strings(); // Throws
     return m_strings;
 }
 
 inline const InternStrings& Changeset::interned_strings() const noexcept
 {
-    return m_strings;
+    return string_owner().m_strings;
 }
 
-inline auto Changeset::string_buffer() noexcept -> std::string&
+inline auto Changeset::string_buffer() -> std::string&
 {
+    unshare_strings(); // Throws
     return m_string_buffer;
 }
 
 inline auto Changeset::string_buffer() const noexcept -> const std::string&
 {
-    return m_string_buffer;
+    return string_owner().m_string_buffer;
+}
+
+inline void Changeset::share_strings(const Changeset& source) noexcept
+{
+    m_string_owner = &source.string_owner();
+}
+
+inline bool Changeset::shares_strings() const noexcept
+{
+    return m_string_owner != nullptr;
+}
+
+inline auto Changeset::string_owner() const noexcept -> const Changeset&
+{
+    return m_string_owner ? *m_string_owner : *this;
+}
+
+inline void Changeset::unshare_strings()
+{
+    if (m_string_owner) {
+        m_string_buffer = m_string_owner->m_string_buffer; // Throws
+        m_strings = m_string_owner->m_strings;             // Throws
+        m_string_owner = nullptr;
+    }
 }
 
 inline util::Optional<StringData> Changeset::try_get_string(StringBufferRange range) const noexcept
 {
-    if (range.offset > m_string_buffer.size())
+    const std::string& buffer = string_buffer();
+    if (range.offset > buffer.size())
         return util::none;
-    if (range.offset + range.size > m_string_buffer.size())
+    if (range.offset + range.size > buffer.size())
         return util::none;
-    return StringData{m_string_buffer.data() + range.offset, range.size};
+    return StringData{buffer.data() + range.offset, range.size};
 }
 
 inline util::Optional<StringData> Changeset::try_get_string(InternString str) const noexcept
@@ -530,11 +571,13 @@ inline StringData Changeset::get_string(InternString string) const noexcept
 
 inline StringData Changeset::string_data() const noexcept
 {
-    return StringData{m_string_buffer.data(), m_string_buffer.size()};
+    const std::string& buffer = string_buffer();
+    return StringData{buffer.data(), buffer.size()};
 }
 
 inline StringBufferRange Changeset::append_string(StringData string)
 {
+    unshare_strings(); // Throws
     // We expect more strings. Only do this at the beginning because until C++20, reserve
     // will shrink_to_fit if the request is less than the current capacity.
     constexpr size_t small_string_buffer_size = 1024;
@@ -673,7 +673,7 @@ BinaryData State::read_buffer(size_t size)
 
 void State::parser_error(std::string_view complaints)
 {
-    throw BadChangesetError{std::string(complaints)};
+    throw BadChangesetParseError{std::string(complaints)};
 }
 
 } // anonymous namespace
@@ -689,11 +689,19 @@ void parse_changeset(util::InputStream& input, Changeset& out_log)
         state.parse_one();
 }
 
+void parse_changeset(util::InputStream& input, InstructionHandler& handler)
+{
+    State state{input, handler};
+
+    while (state.has_next())
+        state.parse_one();
+}
+
 OwnedMixed parse_base64_encoded_primary_key(std::string_view str)
 {
     auto bin_encoded = util::base64_decode_to_vector(str);
     if (!bin_encoded) {
-        throw BadChangesetError("invalid base64 in base64-encoded primary key");
+        throw BadChangesetParseError("invalid base64 in base64-encoded primary key");
     }
     util::SimpleInputStream stream(*bin_encoded);
     UnreachableInstructionHandler fake_encoder;
@@ -718,7 +726,7 @@ OwnedMixed parse_base64_encoded_primary_key(std::string_view str)
         case Type::UUID:
             return OwnedMixed{state.read_uuid()};
         default:
-            throw BadChangesetError(util::format("invalid primary key type %1", static_cast<int>(type)));
+            throw BadChangesetParseError(util::format("invalid primary key type %1", static_cast<int>(type)));
     }
 }
 
@@ -7,8 +7,18 @@
 #include <realm/util/input_stream.hpp>
 
 namespace realm::sync {
+// Thrown by the parser when the encoded changeset is malformed. Errors raised by
+// an InstructionHandler while it is being fed instructions are not wrapped.
+struct BadChangesetParseError : BadChangesetError {
+    using BadChangesetError::BadChangesetError;
+};
+
 void parse_changeset(util::InputStream&, Changeset& out_log);
 
+// Pass each instruction to the handler as soon as it has been parsed instead of
+// collecting them in a Changeset.
+void parse_changeset(util::InputStream&, InstructionHandler&);
+
 // The server may send us primary keys of objects in json-encoded error messages as base64-encoded changeset payloads.
 // This function takes such a base64-encoded payload and returns it parsed as an owned Mixed value. If it cannot
 // be decoded, this throws a BadChangeset exception.
@@ -1,4 +1,5 @@
 #include <realm/sync/instruction_applier.hpp>
+#include <realm/sync/changeset_parser.hpp>
 #include <realm/set.hpp>
 #include <realm/util/scope_exit.hpp>
 
@@ -92,6 +93,57 @@ BinaryData InstructionApplier::get_binary(StringBufferRange range) const
     return BinaryData{string->data(), string->size()};
 }
 
+namespace {
+
+// Applies each instruction as soon as it has been parsed. Interned strings live
+// at the beginning of the string buffer of the changeset. The strings of an
+// instruction are appended after them and dropped once it has been applied, so
+// the buffer never holds more than the interned strings and one instruction.
+struct StreamingApplier : InstructionHandler {
+    StreamingApplier(InstructionApplier& applier, Changeset& log)
+        : m_applier(applier)
+        , m_log(log)
+    {
+        log.interned_strings().clear();
+        log.string_buffer().clear();
+    }
+
+    void set_intern_string(uint32_t index, StringBufferRange range) final
+    {
+        InternStrings& strings = m_log.interned_strings();
+        REALM_ASSERT(index == strings.size());
+        strings.push_back(range);
+        m_interned_size = m_log.string_buffer().size();
+    }
+
+    StringBufferRange add_string_range(StringData string) final
+    {
+        return m_log.append_string(string);
+    }
+
+    void operator()(const Instruction& instr) final
+    {
+        instr.visit(m_applier); // Throws
+        m_log.string_buffer().resize(m_interned_size);
+    }
+
+    InstructionApplier& m_applier;
+    Changeset& m_log;
+    size_t m_interned_size = 0;
+};
+
+} // unnamed namespace
+
+void InstructionApplier::parse_and_apply(util::InputStream& input, Changeset& log)
+{
+    StreamingApplier handler{*this, log};
+    begin_apply(log);
+    auto end_apply_guard = util::make_scope_exit([&]() noexcept {
+        end_apply();
+    });
+    parse_changeset(input, handler); // Throws
+}
+
 TableRef InstructionApplier::table_for_class_name(StringData class_name) const
 {
     if (class_name.size() > Group::max_class_name_length)
@@ -173,6 +225,8 @@ void InstructionApplier::operator()(const Instruction::EraseTable& instr)
     }
 
     m_transaction.remove_table(table_name);
+    m_column_cache.clear();
+    m_link_target_cache.clear();
 }
 
 void InstructionApplier::operator()(const Instruction::CreateObject& instr)
@@ -295,16 +349,7 @@ void InstructionApplier::visit_payload(const Instruction::Payload& payload, F&&
         case Type::Decimal:
             return visitor(data.decimal);
         case Type::Link: {
-            StringData class_name = get_string(data.link.target_table);
-            Group::TableNameBuffer buffer;
-            StringData target_table_name = Group::class_name_to_table_name(class_name, buffer);
-            TableRef target_table = m_transaction.get_table(target_table_name);
-            if (!target_table) {
-                bad_transaction_log("Link with invalid target table '%1'", target_table_name);
-            }
-            if (target_table->is_embedded()) {
-                bad_transaction_log("Link to embedded table '%1'", target_table_name);
-            }
+            TableRef target_table = get_link_target_table(data.link.target_table);
             ObjKey target = get_object_key(*target_table, data.link.target);
             ObjLink link = ObjLink{target_table->get_key(), target};
             return visitor(link);
@@ -679,6 +724,7 @@ void InstructionApplier::operator()(const Instruction::EraseColumn& instr)
     }
 
     table->remove_column(col);
+    m_column_cache.clear();
 }
 
 void InstructionApplier::operator()(const Instruction::ArrayInsert& instr)
@@ -1302,6 +1348,43 @@ StringData InstructionApplier::get_table_name(const Instruction::TableInstructio
     }
 }
 
+ColKey InstructionApplier::get_column_key(const Table& table, InternString field)
+{
+    if (field.value < m_column_cache.size()) {
+        const CachedColumn& cached = m_column_cache[field.value];
+        if (cached.col && cached.table == table.get_key())
+            return cached.col;
+    }
+    ColKey col = table.get_column_key(get_string(field));
+    if (col) {
+        if (field.value >= m_column_cache.size())
+            m_column_cache.resize(m_log->interned_strings().size());
+        m_column_cache[field.value] = {table.get_key(), col};
+    }
+    return col;
+}
+
+TableRef InstructionApplier::get_link_target_table(InternString class_name)
+{
+    if (class_name.value < m_link_target_cache.size()) {
+        if (TableRef table = m_link_target_cache[class_name.value])
+            return table;
+    }
+    Group::TableNameBuffer buffer;
+    StringData target_table_name = Group::class_name_to_table_name(get_string(class_name), buffer);
+    TableRef target_table = m_transaction.get_table(target_table_name);
+    if (!target_table) {
+        bad_transaction_log("Link with invalid target table '%1'", target_table_name);
+    }
+    if (target_table->is_embedded()) {
+        bad_transaction_log("Link to embedded table '%1'", target_table_name);
+    }
+    if (class_name.value >= m_link_target_cache.size())
+        m_link_target_cache.resize(m_log->interned_strings().size());
+    m_link_target_cache[class_name.value] = target_table;
+    return target_table;
+}
+
 TableRef InstructionApplier::get_table(const Instruction::TableInstruction& instr, const std::string_view& name)
 {
     if (instr.table == m_last_table_name) {
@@ -1495,7 +1578,7 @@ InstructionApplier::PathResolver::Status InstructionApplier::PathResolver::resol
 InstructionApplier::PathResolver::Status InstructionApplier::PathResolver::resolve_field(Obj& obj, InternString field)
 {
     auto field_name = get_string(field);
-    ColKey col = obj.get_table()->get_column_key(field_name);
+    ColKey col = m_applier->get_column_key(*obj.get_table(), field);
     if (!col) {
         on_error(util::format("%1: No such field: '%2' in class '%3'", m_instr_name, field_name,
                               obj.get_table()->get_name()));
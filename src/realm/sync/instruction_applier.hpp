@@ -21,6 +21,7 @@
 
 #include <realm/sync/instructions.hpp>
 #include <realm/sync/changeset.hpp>
+#include <realm/util/input_stream.hpp>
 #include <realm/util/logger.hpp>
 #include <realm/list.hpp>
 #include <realm/dictionary.hpp>
@@ -42,6 +43,16 @@ struct InstructionApplier {
     /// BadChangesetError.
     void apply(const Changeset&);
 
+    /// Parse the encoded changeset in \a input and apply each instruction as
+    /// soon as it has been parsed, without building the whole changeset in
+    /// memory. \a log supplies the metadata used in error messages and
+    /// receives the interned strings of the changeset. Other strings are only
+    /// kept until the instruction referring to them has been applied.
+    ///
+    /// Throws BadChangesetParseError if the changeset cannot be parsed, and
+    /// BadChangesetError if it cannot be applied.
+    void parse_and_apply(util::InputStream& input, Changeset& log);
+
     void begin_apply(const Changeset&) noexcept;
     void end_apply() noexcept;
 
@@ -123,7 +134,19 @@ private:
     util::Optional<Obj> m_last_object;
     std::unique_ptr<LstBase> m_last_list;
 
+    // Columns and link target tables resolved while applying the current
+    // changeset, indexed by the interned string of their name. This saves
+    // looking them up by name for every instruction.
+    struct CachedColumn {
+        TableKey table;
+        ColKey col;
+    };
+    std::vector<CachedColumn> m_column_cache;
+    std::vector<TableRef> m_link_target_cache;
+
     StringData get_table_name(const Instruction::TableInstruction&, const std::string_view& instr = "(unspecified)");
+    ColKey get_column_key(const Table&, InternString field);
+    TableRef get_link_target_table(InternString class_name);
 
     // Note: This may return a non-invalid ObjKey if the key is dangling.
     ObjKey get_object_key(Table& table, const Instruction::PrimaryKey&,
@@ -148,6 +171,8 @@ inline InstructionApplier::InstructionApplier(Transaction& group) noexcept
 inline void InstructionApplier::begin_apply(const Changeset& log) noexcept
 {
     m_log = &log;
+    m_column_cache.clear();
+    m_link_target_cache.clear();
 }
 
 inline void InstructionApplier::end_apply() noexcept
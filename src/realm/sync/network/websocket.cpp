@@ -174,7 +174,8 @@ void mask_payload(char* masking_key, const char* payload, size_t payload_len, ch
     }
 }
 
-// make_frame() creates a WebSocket frame according to the WebSocket standard.
+// make_frame_header() writes the header of a WebSocket frame according to the
+// WebSocket standard.
 // \param fin indicates whether the frame is the final fragment in a message.
 // Sync clients and servers will only send unfragmented messages, but they must be
 // prepared to receive fragmented messages.
@@ -189,13 +190,14 @@ void mask_payload(char* masking_key, const char* payload, size_t payload_len, ch
 // receive all.
 // \param mask indicates whether the payload of the frame should be masked. Frames
 // are masked if and only if they originate from the client.
-// The payload is located in the buffer \param payload, and has size \param payload_size.
-// \param output is the output buffer. It must be large enough to contain the frame.
-// The frame size can at most be payload_size + 14.
+// \param payload_size is the size of the payload that will follow the header.
+// \param output is the output buffer. The header size is at most 14.
+// \param masking_key receives the random masking key when \param mask is
+// true. It must then be used to mask the payload.
 // \param random is used to create a random masking key.
-// The return value is the size of the frame.
-size_t make_frame(bool fin, int opcode, bool mask, const char* payload, size_t payload_size, char* output,
-                  std::mt19937_64& random)
+// The return value is the size of the header.
+size_t make_frame_header(bool fin, int opcode, bool mask, size_t payload_size, char* output, char* masking_key,
+                         std::mt19937_64& random)
 {
     int index = 0; // used to keep track of position within the header.
     using uchar = unsigned char;
@@ -228,7 +230,6 @@ size_t make_frame(bool fin, int opcode, bool mask, const char* payload, size_t p
         index = 10;
     }
     if (mask) {
-        char masking_key[4];
         std::uniform_int_distribution<> dis(0, 255);
         for (int i = 0; i < 4; ++i) {
             masking_key[i] = dis(random);
@@ -237,6 +238,22 @@ size_t make_frame(bool fin, int opcode, bool mask, const char* payload, size_t p
         output[index++] = masking_key[1];
         output[index++] = masking_key[2];
         output[index++] = masking_key[3];
+    }
+
+    return size_t(index);
+}
+
+// make_frame() creates a complete WebSocket frame using make_frame_header().
+// The payload is located in the buffer \param payload, and has size \param
+// payload_size. \param output is the output buffer. It must be large enough to
+// contain the frame. The frame size can at most be payload_size + 14.
+// The return value is the size of the frame.
+size_t make_frame(bool fin, int opcode, bool mask, const char* payload, size_t payload_size, char* output,
+                  std::mt19937_64& random)
+{
+    char masking_key[4];
+    size_t index = make_frame_header(fin, opcode, mask, payload_size, output, masking_key, random);
+    if (mask) {
         mask_payload(masking_key, payload, payload_size, output + index);
     }
     else {
@@ -688,7 +705,51 @@ public:
         size_t message_size =
             make_frame(fin, opcode, mask, data, size, m_write_buffer.data(), m_config.websocket_get_random());
 
-        auto handler = [this, handler = std::move(write_completion_handler)](std::error_code ec, size_t) mutable {
+        m_config.async_write(m_write_buffer.data(), message_size,
+                             make_write_handler(std::move(write_completion_handler)));
+    }
+
+    void async_write_frame(bool fin, int opcode, const char* data, size_t size, const char* data_2, size_t size_2,
+                           sync::websocket::WriteCompletionHandler write_completion_handler)
+    {
+        REALM_ASSERT(!m_stopped);
+
+        if (m_is_client) {
+            // The payload must be masked, so it has to be copied anyway.
+            std::vector<char> payload;
+            payload.reserve(size + size_2);                         // Throws
+            payload.insert(payload.end(), data, data + size);       // Throws
+            payload.insert(payload.end(), data_2, data_2 + size_2); // Throws
+            async_write_frame(fin, opcode, payload.data(), payload.size(),
+                              std::move(write_completion_handler)); // Throws
+            return;
+        }
+
+        // Only the frame header and the first part of the payload are copied
+        // into the write buffer. The second part is written directly from the
+        // buffer of the caller.
+        size_t required_size = size + 14;
+        if (m_write_buffer.size() < required_size)
+            m_write_buffer.resize(required_size);
+
+        char masking_key[4];
+        size_t header_size = make_frame_header(fin, opcode, false, size + size_2, m_write_buffer.data(), masking_key,
+                                               m_config.websocket_get_random());
+        std::copy(data, data + size, m_write_buffer.data() + header_size);
+
+        auto handler = [this, data_2, size_2, handler = make_write_handler(std::move(write_completion_handler))](
+                           std::error_code ec, size_t num_bytes_transferred) mutable {
+            if (ec || size_2 == 0)
+                return handler(ec, num_bytes_transferred);
+            m_config.async_write(data_2, size_2, std::move(handler));
+        };
+
+        m_config.async_write(m_write_buffer.data(), header_size + size, std::move(handler));
+    }
+
+    sync::websocket::WriteCompletionHandler make_write_handler(sync::websocket::WriteCompletionHandler handler)
+    {
+        return [this, handler = std::move(handler)](std::error_code ec, size_t) mutable {
             // If the operation is aborted, then the write operation was canceled and we should ignore this callback.
             if (ec == util::error::operation_aborted) {
                 return handler(ec, 0);
@@ -712,8 +773,6 @@ public:
 
             handle_write_message(std::move(handler));
         };
-
-        m_config.async_write(m_write_buffer.data(), message_size, std::move(handler));
     }
 
     void handle_write_message(sync::websocket::WriteCompletionHandler write_handler)
@@ -1273,6 +1332,12 @@ void websocket::Socket::async_write_frame(bool fin, Opcode opcode, const char* d
     m_impl->async_write_frame(fin, int(opcode), data, size, std::move(handler));
 }
 
+void websocket::Socket::async_write_binary(const char* data, size_t size, const char* data_2, size_t size_2,
+                                           WriteCompletionHandler handler)
+{
+    m_impl->async_write_frame(true, int(Opcode::binary), data, size, data_2, size_2, std::move(handler));
+}
+
 void websocket::Socket::async_write_text(const char* data, size_t size, WriteCompletionHandler handler)
 {
     async_write_frame(true, Opcode::text, data, size, std::move(handler));
@@ -159,6 +159,15 @@ public:
     void async_write_pong(const char* data, size_t size, WriteCompletionHandler handler);
     //@}
 
+    /// Send a binary message whose payload is the concatenation of
+    /// `data`/`size` and `data_2`/`size_2`. Unless the payload must be masked
+    /// (client side), the second part is written directly from the specified
+    /// buffer, which must therefore stay valid until the completion handler
+    /// is called. This allows large message bodies that are shared between
+    /// several connections to be sent without copying them.
+    void async_write_binary(const char* data, size_t size, const char* data_2, size_t size_2,
+                            WriteCompletionHandler handler);
+
     /// stop() stops the socket. The socket will stop processing incoming data,
     /// sending data, and calling callbacks.  It is an error to attempt to send
     /// a message after stop() has been called. stop() will typically be called
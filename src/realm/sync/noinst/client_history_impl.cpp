@@ -18,6 +18,7 @@
 
 #include <realm/sync/noinst/client_history_impl.hpp>
 
+#include <realm/array_blob.hpp>
 #include <realm/sync/changeset.hpp>
 #include <realm/sync/changeset_parser.hpp>
 #include <realm/sync/instruction_applier.hpp>
@@ -32,11 +33,109 @@
 #include <realm/version.hpp>
 
 #include <algorithm>
+#include <condition_variable>
 #include <ctime>
 #include <cstring>
+#include <mutex>
+#include <optional>
+#include <thread>
 #include <utility>
 
 namespace realm::sync {
+namespace {
+
+// When other writers are waiting for the write lock, it is released once the
+// integrated changes reach this size. Changesets parsed by a BackgroundParser
+// are integrated in batches of this size.
+constexpr std::size_t commit_byte_size_limit = 102400; // 100 KB
+
+// Download messages at least this large are parsed by a BackgroundParser.
+constexpr std::size_t min_pipelined_download_size = 2 * commit_byte_size_limit;
+
+// Parses the changesets of a download message on a separate thread, in order,
+// so that the first changesets can be transformed, applied and committed while
+// the later ones are still being parsed.
+class BackgroundParser {
+public:
+    BackgroundParser(util::Span<const RemoteChangeset> incoming_changesets, util::Span<Changeset> changesets)
+        : m_incoming_changesets(incoming_changesets)
+        , m_changesets(changesets)
+    {
+        m_end_offsets.reserve(incoming_changesets.size()); // Throws
+        std::size_t offset = 0;
+        for (const RemoteChangeset& changeset : incoming_changesets) {
+            offset += changeset.data.size();
+            m_end_offsets.push_back(offset);
+        }
+        m_thread = std::thread([this] {
+            run();
+        });
+    }
+
+    ~BackgroundParser()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_cancelled = true;
+        }
+        m_thread.join();
+    }
+
+    // Wait until the changesets from index `begin` and onwards that have been
+    // parsed make up at least `min_size` bytes of received data, or until all
+    // changesets have been parsed. Returns the number of changesets parsed so
+    // far, which is greater than `begin`. If parsing the changeset at index
+    // `begin` failed, the exception is rethrown.
+    std::size_t wait_for(std::size_t begin, std::size_t min_size)
+    {
+        std::size_t begin_offset = begin == 0 ? 0 : m_end_offsets[begin - 1];
+        std::unique_lock lock(m_mutex);
+        m_cv.wait(lock, [&] {
+            if (m_num_parsed == m_changesets.size() || m_error)
+                return true;
+            return m_num_parsed > begin && m_end_offsets[m_num_parsed - 1] - begin_offset >= min_size;
+        });
+        if (m_num_parsed <= begin)
+            std::rethrow_exception(m_error);
+        return m_num_parsed;
+    }
+
+private:
+    void run()
+    {
+        for (std::size_t i = 0; i < m_changesets.size(); ++i) {
+            std::exception_ptr error;
+            try {
+                parse_remote_changeset(m_incoming_changesets[i], m_changesets[i]); // Throws
+            }
+            catch (...) {
+                error = std::current_exception();
+            }
+            std::lock_guard lock(m_mutex);
+            if (error) {
+                m_error = error;
+            }
+            else {
+                ++m_num_parsed;
+            }
+            m_cv.notify_one();
+            if (m_error || m_cancelled)
+                return;
+        }
+    }
+
+    const util::Span<const RemoteChangeset> m_incoming_changesets;
+    const util::Span<Changeset> m_changesets;
+    std::vector<std::size_t> m_end_offsets;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::size_t m_num_parsed = 0;
+    std::exception_ptr m_error;
+    bool m_cancelled = false;
+    std::thread m_thread;
+};
+
+} // unnamed namespace
 
 void ClientHistory::set_history_adjustments(
     util::Logger& logger, version_type current_version, SaltedFileIdent client_file_ident,
@@ -81,7 +180,8 @@ void ClientHistory::set_history_adjustments(
         for (auto& [changeset, version] : recovered_changesets) {
             uploadable_bytes += changeset.size();
             auto i = size_t(version - m_sync_history_base_version);
-            util::compression::allocate_and_compress_nonportable(arena, changeset, compressed);
+            util::compression::allocate_and_compress_nonportable(arena, changeset, compressed,
+                                                                 get_compression_dictionary());
             m_arrays->changesets.set(i, BinaryData{compressed.data(), compressed.size()}); // Throws
             m_arrays->reciprocal_transforms.set(i, BinaryData());
         }
@@ -158,7 +258,7 @@ std::vector<ClientHistory::LocalChange> ClientHistory::get_local_changes(version
             // otherwise adds 1 to the version, and then get_reciprocal_transform()
             // subtracts 1 from the version
             if (auto changeset = get_reciprocal_transform(version + 1, compressed); !changeset.empty()) {
-                changesets.push_back({version, changeset});
+                changesets.push_back({version, changeset, get_compression_dictionary()});
             }
         }
     }
@@ -195,7 +295,7 @@ int ClientReplication::get_history_schema_version() const noexcept
 // Overriding member function in realm::Replication
 bool ClientReplication::is_upgradable_history_schema(int stored_schema_version) const noexcept
 {
-    if (stored_schema_version == 11) {
+    if (stored_schema_version == 11 || stored_schema_version == 12) {
         return true;
     }
     return false;
@@ -219,6 +319,11 @@ void ClientReplication::upgrade_history_schema(int stored_schema_version)
         schema_version = 12;
     }
 
+    if (schema_version < 13) {
+        m_history.add_compression_dictionary_slot();
+        schema_version = 13;
+    }
+
     // NOTE: Future migration steps go here.
 
     REALM_ASSERT(schema_version == get_client_history_schema_version());
@@ -229,27 +334,43 @@ void ClientReplication::upgrade_history_schema(int stored_schema_version)
 
 void ClientHistory::compress_stored_changesets()
 {
+    // The root array does not have all slots of the current schema version
+    // yet, so the columns are accessed directly rather than through Arrays.
     using gf = _impl::GroupFriend;
     Allocator& alloc = gf::get_alloc(*m_group);
-    auto ref = gf::get_history_ref(*m_group);
-    Arrays arrays{alloc, m_group, ref};
+    Array root{alloc};
+    gf::set_history_parent(*m_group, root);
+    root.init_from_ref(gf::get_history_ref(*m_group));
 
     util::AppendBuffer<char> compressed_buffer;
     util::AppendBuffer<char> decompressed_buffer;
     util::compression::CompressMemoryArena arena;
-    auto columns = {&arrays.reciprocal_transforms, &arrays.changesets};
-    for (auto column : columns) {
-        for (size_t i = 0; i < column->size(); ++i) {
-            ChunkedBinaryData data(*column, i);
+    for (int ndx_in_parent : {s_reciprocal_transforms_iip, s_changesets_iip}) {
+        BinaryColumn column{alloc};
+        column.set_parent(&root, ndx_in_parent);
+        column.init_from_parent();
+        for (size_t i = 0; i < column.size(); ++i) {
+            ChunkedBinaryData data(column, i);
             if (data.is_null())
                 continue;
             data.copy_to(compressed_buffer);
             util::compression::allocate_and_compress_nonportable(arena, compressed_buffer, decompressed_buffer);
-            column->set(i, BinaryData{decompressed_buffer.data(), decompressed_buffer.size()}); // Throws
+            column.set(i, BinaryData{decompressed_buffer.data(), decompressed_buffer.size()}); // Throws
         }
     }
 }
 
+void ClientHistory::add_compression_dictionary_slot()
+{
+    using gf = _impl::GroupFriend;
+    Allocator& alloc = gf::get_alloc(*m_group);
+    Array root{alloc};
+    gf::set_history_parent(*m_group, root);
+    root.init_from_ref(gf::get_history_ref(*m_group));
+    REALM_ASSERT(root.size() == s_compression_dictionary_iip);
+    root.add(0); // Throws
+}
+
 // Overriding member function in realm::Replication
 auto ClientReplication::prepare_changeset(const char* data, size_t size, version_type orig_version) -> version_type
 {
@@ -398,7 +519,8 @@ void ClientHistory::find_uploadable_changesets(UploadCursor& upload_progress, ve
         UploadChangeset uc;
         util::AppendBuffer<char> decompressed;
         ChunkedBinaryInputStream is_2(entry.changeset);
-        auto ec = util::compression::decompress_nonportable(is_2, decompressed);
+        auto ec =
+            util::compression::decompress_nonportable(is_2, decompressed, get_compression_dictionary(arrays.root));
         if (ec == util::compression::error::decompress_unsupported) {
             REALM_TERMINATE(
                 "Synchronized Realm files with unuploaded local changes cannot be copied between platforms.");
@@ -432,13 +554,38 @@ void ClientHistory::integrate_server_changesets(
     std::vector<Changeset> changesets;
     changesets.resize(incoming_changesets.size()); // Throws
 
+    // The changesets of a bootstrap batch are integrated while holding the
+    // write lock anyway, so they are parsed on demand by
+    // transform_and_apply_server_changesets(). This allows them to be applied
+    // straight from the received data when there are no local changes to merge
+    // them with.
+    const bool parse_on_demand = batch_state != DownloadBatchState::SteadyState;
+
+    // Large download messages are parsed in the background while the
+    // changesets parsed so far are integrated. Transformation has to wait for
+    // the previous commit, as it depends on the history, so only parsing can
+    // overlap with the rest of the integration.
+    std::size_t download_size = 0;
+    for (const RemoteChangeset& changeset : incoming_changesets)
+        download_size += changeset.data.size();
+    const bool parse_in_background =
+        !parse_on_demand && incoming_changesets.size() > 1 && download_size >= min_pipelined_download_size;
+    std::optional<BackgroundParser> background_parser;
+
     // Parse incoming changesets without holding the write lock unless 'transact' is specified.
     try {
         for (std::size_t i = 0; i < incoming_changesets.size(); ++i) {
             const RemoteChangeset& changeset = incoming_changesets[i];
-            parse_remote_changeset(changeset, changesets[i]); // Throws
+            if (parse_on_demand) {
+                copy_remote_changeset_metadata(changeset, changesets[i]);
+            }
+            else if (!parse_in_background) {
+                parse_remote_changeset(changeset, changesets[i]); // Throws
+            }
             changesets[i].transform_sequence = i;
         }
+        if (parse_in_background)
+            background_parser.emplace(incoming_changesets, changesets);
     }
     catch (const BadChangesetError& e) {
         throw IntegrationException(ErrorCodes::BadChangeset,
@@ -456,6 +603,22 @@ void ClientHistory::integrate_server_changesets(
     // In each iteration, at least one changeset is transformed and committed.
     // In FLX, all changesets are committed at once in the bootstrap phase (i.e, in one iteration).
     while (!changesets_to_integrate.empty()) {
+        std::size_t num_parsed = changesets_to_integrate.size();
+        if (background_parser) {
+            // Integrate the changesets parsed so far, once they make up as
+            // much data as is otherwise committed at a time.
+            std::size_t num_integrated = num_changesets - changesets_to_integrate.size();
+            try {
+                num_parsed = background_parser->wait_for(num_integrated, commit_byte_size_limit) -
+                             num_integrated; // Throws
+            }
+            catch (const BadChangesetError& e) {
+                throw IntegrationException(ErrorCodes::BadChangeset,
+                                           util::format("Failed to parse received changeset: %1", e.what()),
+                                           ProtocolError::bad_changeset);
+            }
+        }
+
         if (transact->get_transact_stage() == DB::transact_Reading) {
             transact->promote_to_write(); // Throws
         }
@@ -469,7 +632,8 @@ void ClientHistory::integrate_server_changesets(
 
         std::uint64_t downloaded_bytes_in_transaction = 0;
         auto changesets_transformed_count = transform_and_apply_server_changesets(
-            changesets_to_integrate, transact, logger, downloaded_bytes_in_transaction, allow_lock_release);
+            changesets_to_integrate.first(num_parsed), incoming_changesets.first(num_parsed), parse_on_demand,
+            transact, logger, downloaded_bytes_in_transaction, allow_lock_release);
 
         // downloaded_bytes always contains the total number of downloaded bytes
         // from the Realm. downloaded_bytes must be persisted in the Realm, since
@@ -544,10 +708,14 @@ void ClientHistory::integrate_server_changesets(
 
 
 size_t ClientHistory::transform_and_apply_server_changesets(util::Span<Changeset> changesets_to_integrate,
-                                                            TransactionRef transact, util::Logger& logger,
-                                                            std::uint64_t& downloaded_bytes, bool allow_lock_release)
+                                                            util::Span<const RemoteChangeset> incoming_changesets,
+                                                            bool parse_on_demand, TransactionRef transact,
+                                                            util::Logger& logger, std::uint64_t& downloaded_bytes,
+                                                            bool allow_lock_release)
 {
     REALM_ASSERT(transact->get_transact_stage() == DB::transact_Writing);
+    REALM_ASSERT(changesets_to_integrate.size() == incoming_changesets.size());
+    REALM_ASSERT(!parse_on_demand || !allow_lock_release);
 
     if (!m_replication.apply_server_changes()) {
         std::for_each(changesets_to_integrate.begin(), changesets_to_integrate.end(), [&](const Changeset& c) {
@@ -579,7 +747,45 @@ size_t ClientHistory::transform_and_apply_server_changesets(util::Span<Changeset
                 changeset.last_integrated_remote_version = m_sync_history_base_version;
         }
 
-        constexpr std::size_t commit_byte_size_limit = 102400; // 100 KB
+        if (parse_on_demand) {
+            bool must_transform =
+                std::any_of(changesets_to_integrate.begin(), changesets_to_integrate.end(), [&](const Changeset& c) {
+                    HistoryEntry entry;
+                    return find_history_entry(c.last_integrated_remote_version, local_version, entry) != 0;
+                });
+            if (!must_transform) {
+                // Nothing to merge with, so each instruction can be applied as
+                // soon as it has been parsed.
+                try {
+                    for (size_t i = 0; i < incoming_changesets.size(); ++i) {
+                        ChunkedBinaryInputStream in{incoming_changesets[i].data};
+                        InstructionApplier applier{*transact};
+                        {
+                            TempShortCircuitReplication tscr{m_replication};
+                            applier.parse_and_apply(in, changesets_to_integrate[i]); // Throws
+                        }
+                        downloaded_bytes += changesets_to_integrate[i].original_changeset_size;
+                    }
+                }
+                catch (const BadChangesetParseError& e) {
+                    throw IntegrationException(ErrorCodes::BadChangeset,
+                                               util::format("Failed to parse received changeset: %1", e.what()),
+                                               ProtocolError::bad_changeset);
+                }
+                return changesets_to_integrate.size();
+            }
+            try {
+                for (size_t i = 0; i < incoming_changesets.size(); ++i) {
+                    ChunkedBinaryInputStream in{incoming_changesets[i].data};
+                    parse_changeset(in, changesets_to_integrate[i]); // Throws
+                }
+            }
+            catch (const BadChangesetError& e) {
+                throw IntegrationException(ErrorCodes::BadChangeset,
+                                           util::format("Failed to parse received changeset: %1", e.what()),
+                                           ProtocolError::bad_changeset);
+            }
+        }
 
         auto changeset_applier = [&](const Changeset* transformed_changeset) -> bool {
             InstructionApplier applier{*transact};
@@ -719,11 +925,32 @@ void ClientHistory::set_reciprocal_transform(version_type version, BinaryData da
         return;
     }
 
-    auto compressed = util::compression::allocate_and_compress_nonportable(data);
+    auto compressed = util::compression::allocate_and_compress_nonportable(data, get_compression_dictionary());
     m_arrays->reciprocal_transforms.set(index, BinaryData{compressed.data(), compressed.size()}); // Throws
 }
 
 
+util::Span<const char> ClientHistory::get_compression_dictionary() const noexcept
+{
+    if (!m_arrays)
+        return {};
+    return get_compression_dictionary(m_arrays->root);
+}
+
+
+// The dictionary is read from the root array of the transaction that the
+// history entries are read from, which is not necessarily the one `m_arrays`
+// is bound to.
+util::Span<const char> ClientHistory::get_compression_dictionary(const Array& root) noexcept
+{
+    ref_type ref = root.get_as_ref(s_compression_dictionary_iip);
+    if (ref == 0)
+        return {};
+    const char* header = root.get_alloc().translate(ref);
+    return {ArrayBlob::get(header, 0), NodeHeader::get_size_from_header(header)};
+}
+
+
 auto ClientHistory::find_sync_history_entry(Arrays& arrays, version_type base_version, version_type begin_version,
                                             version_type end_version, HistoryEntry& entry,
                                             version_type& last_integrated_server_version) noexcept -> version_type
@@ -861,8 +1088,10 @@ void ClientHistory::add_sync_history_entry(const HistoryEntry& entry)
     REALM_ASSERT(m_arrays->origin_timestamps.size() == sync_history_size());
 
     if (!entry.changeset.is_null()) {
+        maybe_create_compression_dictionary(); // Throws
         auto changeset = entry.changeset.get_first_chunk();
-        auto compressed = util::compression::allocate_and_compress_nonportable(changeset);
+        auto compressed =
+            util::compression::allocate_and_compress_nonportable(changeset, get_compression_dictionary());
         m_arrays->changesets.add(BinaryData{compressed.data(), compressed.size()}); // Throws
     }
     else {
@@ -876,6 +1105,56 @@ void ClientHistory::add_sync_history_entry(const HistoryEntry& entry)
 }
 
 
+// Most changesets are small, and on their own compress poorly or not at all.
+// They do however tend to repeat the same class and property names, primary
+// keys and instruction sequences as the changesets before them, so once the
+// history holds enough data, the most recent changesets are stored as a
+// dictionary which subsequent history entries are compressed against. The
+// dictionary never changes once created, as the entries compressed with it
+// would otherwise become unreadable.
+void ClientHistory::maybe_create_compression_dictionary()
+{
+    Array& root = m_arrays->root;
+    if (root.get_as_ref(s_compression_dictionary_iip) != 0)
+        return;
+
+    // Find the most recent entries which together fill the dictionary
+    std::size_t end = sync_history_size();
+    std::size_t begin = end - std::min(end, s_compression_dictionary_max_sample_entries);
+    std::size_t sample_size = 0;
+    while (begin < end && sample_size < s_compression_dictionary_size) {
+        --end;
+        ChunkedBinaryData changeset{m_arrays->changesets, end};
+        ChunkedBinaryInputStream in{changeset};
+        sample_size += util::compression::get_uncompressed_size_from_header(in);
+    }
+    if (sample_size < s_compression_dictionary_min_size)
+        return;
+
+    std::string dictionary;
+    dictionary.reserve(sample_size);
+    util::AppendBuffer<char> decompressed;
+    for (std::size_t i = end, size = sync_history_size(); i < size; ++i) {
+        ChunkedBinaryData changeset{m_arrays->changesets, i};
+        ChunkedBinaryInputStream in{changeset};
+        if (util::compression::decompress_nonportable(in, decompressed))
+            return; // Unreadable on this platform, so don't use it
+        dictionary.append(decompressed.data(), decompressed.size());
+    }
+    // Matches close to the end of the dictionary are the cheapest to encode,
+    // so that is where the most recent changesets are kept.
+    if (dictionary.size() > s_compression_dictionary_size)
+        dictionary.erase(0, dictionary.size() - s_compression_dictionary_size);
+
+    ArrayBlob blob{root.get_alloc()};
+    blob.create(); // Throws
+    _impl::ShallowArrayDestroyGuard adg{&blob};
+    blob.add(dictionary.data(), dictionary.size());                  // Throws
+    root.set_as_ref(s_compression_dictionary_iip, blob.get_ref()); // Throws
+    adg.release();                                                   // Ownership transferred to parent array
+}
+
+
 void ClientHistory::update_sync_progress(const SyncProgress& progress, DownloadableProgress downloadable_bytes)
 {
     Array& root = m_arrays->root;
@@ -980,11 +1259,7 @@ void ClientHistory::trim_ct_history()
     // history empty.
     REALM_ASSERT(n < ct_history_size());
 
-    for (std::size_t i = 0; i < n; ++i) {
-        std::size_t j = (n - 1) - i;
-        m_arrays->ct_history.erase(j);
-    }
-
+    m_arrays->ct_history.erase_front(n); // Throws
     m_ct_history_base_version += n;
 
     REALM_ASSERT(m_ct_history_base_version + ct_history_size() == m_sync_history_base_version + sync_history_size());
@@ -1089,35 +1364,14 @@ void ClientHistory::do_trim_sync_history(std::size_t n)
     REALM_ASSERT(m_arrays->origin_timestamps.size() == sync_history_size());
     REALM_ASSERT(n <= sync_history_size());
 
-    if (n == sync_history_size()) {
-        m_arrays->changesets.clear();
-        m_arrays->reciprocal_transforms.clear();
-        m_arrays->remote_versions.clear();
-        m_arrays->origin_file_idents.clear();
-        m_arrays->origin_timestamps.clear();
-    }
-    else if (n > 0) {
-        for (std::size_t i = 0; i < n; ++i) {
-            std::size_t j = (n - 1) - i;
-            m_arrays->changesets.erase(j); // Throws
-        }
-        for (std::size_t i = 0; i < n; ++i) {
-            std::size_t j = (n - 1) - i;
-            m_arrays->reciprocal_transforms.erase(j); // Throws
-        }
-        for (std::size_t i = 0; i < n; ++i) {
-            std::size_t j = (n - 1) - i;
-            m_arrays->remote_versions.erase(j); // Throws
-        }
-        for (std::size_t i = 0; i < n; ++i) {
-            std::size_t j = (n - 1) - i;
-            m_arrays->origin_file_idents.erase(j); // Throws
-        }
-        for (std::size_t i = 0; i < n; ++i) {
-            std::size_t j = (n - 1) - i;
-            m_arrays->origin_timestamps.erase(j); // Throws
-        }
-    }
+    // Whole leaves of the history columns are dropped at once, so the cost
+    // depends on the number of trimmed entries, and not on the number of
+    // entries that remain.
+    m_arrays->changesets.erase_front(n);            // Throws
+    m_arrays->reciprocal_transforms.erase_front(n); // Throws
+    m_arrays->remote_versions.erase_front(n);       // Throws
+    m_arrays->origin_file_idents.erase_front(n);    // Throws
+    m_arrays->origin_timestamps.erase_front(n);     // Throws
 
     m_sync_history_base_version += n;
 }
@@ -1157,7 +1411,8 @@ void ClientHistory::fix_up_client_file_ident_in_stored_changesets(Transaction& g
         ChunkedBinaryData changeset{m_arrays->changesets, i};
         ChunkedBinaryInputStream is{changeset};
         size_t decompressed_size;
-        auto decompressed = util::compression::decompress_nonportable_input_stream(is, decompressed_size);
+        auto decompressed = util::compression::decompress_nonportable_input_stream(is, decompressed_size,
+                                                                                   get_compression_dictionary());
         if (!decompressed)
             continue;
         Changeset log;
@@ -1203,7 +1458,8 @@ void ClientHistory::fix_up_client_file_ident_in_stored_changesets(Transaction& g
         if (did_modify) {
             ChangesetEncoder::Buffer modified;
             encode_changeset(log, modified);
-            util::compression::allocate_and_compress_nonportable(arena, modified, compressed);
+            util::compression::allocate_and_compress_nonportable(arena, modified, compressed,
+                                                                 get_compression_dictionary());
             m_arrays->changesets.set(i, BinaryData{compressed.data(), compressed.size()}); // Throws
 
             uploadable_bytes += modified.size() - decompressed_size;
@@ -67,10 +67,12 @@ class ClientReplication;
 //       Cooked history was removed, except to verify that there is no cooked history.
 //
 //  12   History entries are compressed.
+//
+//  13   Added a slot for a compression dictionary to the root array.
 
 constexpr int get_client_history_schema_version() noexcept
 {
-    return 12;
+    return 13;
 }
 
 class IntegrationException : public Exception {
@@ -114,6 +116,8 @@ public:
     struct LocalChange {
         version_type version;
         ChunkedBinaryData changeset;
+        /// The dictionary which `changeset` may have been compressed with.
+        util::Span<const char> compression_dictionary;
     };
     /// get_local_changes returns a list of changes which have not been uploaded yet
     /// 'current_version' is the version that the history should be updated to.
@@ -272,6 +276,7 @@ public:
     version_type find_history_entry(version_type, version_type, HistoryEntry&) const noexcept override;
     ChunkedBinaryData get_reciprocal_transform(version_type, bool&) const override;
     void set_reciprocal_transform(version_type, BinaryData) override;
+    util::Span<const char> get_compression_dictionary() const noexcept override;
 
 public: // Stuff in this section is only used by CLI tools.
     /// set_local_origin_timestamp_override() allows you to override the origin timestamp of new changesets
@@ -341,7 +346,7 @@ private:
     // clang-format off
 
     // Sizes of fixed-size arrays
-    static constexpr int s_root_size            = 21;
+    static constexpr int s_root_size            = 22;
     static constexpr int s_schema_versions_size =  4;
 
     // Slots in root array of history compartment
@@ -366,6 +371,7 @@ private:
     static constexpr int s_object_id_history_state_iip = 18;            // ref
     static constexpr int s_cooked_history_iip = 19;                     // ref (removed)
     static constexpr int s_schema_versions_iip = 20;                    // table ref
+    static constexpr int s_compression_dictionary_iip = 21;             // blob ref
 
     // Slots in root array of `schema_versions` table
     static constexpr int s_sv_schema_versions_iip = 0;   // integer
@@ -375,6 +381,14 @@ private:
 
     // clang-format on
 
+    // Maximum and minimum size of the compression dictionary, and the number of
+    // most recent history entries that are considered when building it. Every
+    // compression has to load the dictionary, so a larger one costs more time
+    // than it saves space.
+    static constexpr std::size_t s_compression_dictionary_size = 4 * 1024;
+    static constexpr std::size_t s_compression_dictionary_min_size = 2 * 1024;
+    static constexpr std::size_t s_compression_dictionary_max_sample_entries = 256;
+
     // The construction of the array accessors need to be delayed, because the
     // allocator (Allocator) is not known at the time of construction of the
     // ServerHistory object.
@@ -414,9 +428,13 @@ private:
     std::uint_fast64_t sum_of_history_entry_sizes(version_type begin_version,
                                                   version_type end_version) const noexcept;
 
-    size_t transform_and_apply_server_changesets(util::Span<Changeset> changesets_to_integrate, TransactionRef,
-                                                 util::Logger&, std::uint64_t& downloaded_bytes,
-                                                 bool allow_lock_release);
+    // If `parse_on_demand` is true, `changesets_to_integrate` only hold the
+    // metadata of `incoming_changesets`, and are parsed here if they need to
+    // be transformed.
+    size_t transform_and_apply_server_changesets(util::Span<Changeset> changesets_to_integrate,
+                                                 util::Span<const RemoteChangeset> incoming_changesets,
+                                                 bool parse_on_demand, TransactionRef, util::Logger&,
+                                                 std::uint64_t& downloaded_bytes, bool allow_lock_release);
 
     void prepare_for_write();
     Replication::version_type add_changeset(BinaryData changeset, BinaryData sync_changeset);
@@ -430,6 +448,9 @@ private:
     void record_current_schema_version();
     static void record_current_schema_version(Array& schema_versions, version_type snapshot_version);
     void compress_stored_changesets();
+    void add_compression_dictionary_slot();
+    void maybe_create_compression_dictionary();
+    static util::Span<const char> get_compression_dictionary(const Array& root) noexcept;
 
     size_t sync_history_size() const noexcept
     {
@@ -163,7 +163,7 @@ private:
 
 struct RecoverLocalChangesetsHandler : public sync::InstructionApplier {
     RecoverLocalChangesetsHandler(Transaction& dest_wt, Transaction& frozen_pre_local_state, util::Logger& logger);
-    util::AppendBuffer<char> process_changeset(const ChunkedBinaryData& changeset);
+    util::AppendBuffer<char> process_changeset(const sync::ClientHistory::LocalChange& change);
 
 private:
     using Instruction = sync::Instruction;
@@ -499,11 +499,13 @@ REALM_NORETURN void RecoverLocalChangesetsHandler::handle_error(const std::strin
     throw realm::sync::ClientResetFailed(full_message);
 }
 
-util::AppendBuffer<char> RecoverLocalChangesetsHandler::process_changeset(const ChunkedBinaryData& changeset)
+util::AppendBuffer<char>
+RecoverLocalChangesetsHandler::process_changeset(const sync::ClientHistory::LocalChange& change)
 {
-    ChunkedBinaryInputStream in{changeset};
+    ChunkedBinaryInputStream in{change.changeset};
     size_t decompressed_size;
-    auto decompressed = util::compression::decompress_nonportable_input_stream(in, decompressed_size);
+    auto decompressed =
+        util::compression::decompress_nonportable_input_stream(in, decompressed_size, change.compression_dictionary);
     if (!decompressed)
         return {};
 
@@ -1212,7 +1214,7 @@ client_reset::process_recovered_changesets(Transaction& dest_tr, Transaction& pr
     RecoverLocalChangesetsHandler handler(dest_tr, pre_reset_state, logger);
     std::vector<RecoveredChange> encoded;
     for (auto& local_change : local_changes) {
-        encoded.push_back({handler.process_changeset(local_change.changeset), local_change.version});
+        encoded.push_back({handler.process_changeset(local_change), local_change.version});
     }
     return encoded;
 }
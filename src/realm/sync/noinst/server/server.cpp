@@ -47,6 +47,7 @@
 #include <cstdio>
 #include <cstring>
 #include <functional>
+#include <list>
 #include <locale>
 #include <map>
 #include <memory>
@@ -190,6 +191,7 @@ bool determine_try_again(ProtocolError error_code) noexcept
 
 class ServerFile;
 class ServerImpl;
+class Worker;
 class HTTPConnection;
 class SyncConnection;
 class Session;
@@ -218,7 +220,7 @@ public:
 };
 
 
-struct DownloadCache {
+struct DownloadCacheEntry {
     std::unique_ptr<char[]> body;
     std::size_t uncompressed_body_size;
     std::size_t compressed_body_size;
@@ -229,6 +231,91 @@ struct DownloadCache {
     std::size_t num_changesets;
     std::size_t accum_original_size;
     std::size_t accum_compacted_size;
+
+    std::size_t body_size() const noexcept
+    {
+        return (body_is_compressed ? compressed_body_size : uncompressed_body_size);
+    }
+};
+
+
+// The DOWNLOAD message bodies used for client bootstrapping, keyed by file and
+// server version. When the accumulated size of the bodies exceeds the limit,
+// the least recently used ones are discarded. The bodies are shared with the
+// connections that are sending them, so discarding an entry never invalidates
+// a body that is still being sent. Must only be accessed by the network event
+// loop thread.
+class DownloadCache {
+public:
+    using Entry = std::shared_ptr<const DownloadCacheEntry>;
+
+    explicit DownloadCache(std::size_t max_size) noexcept
+        : m_max_size{max_size}
+    {
+    }
+
+    Entry get(const ServerFile* file, version_type end_version)
+    {
+        auto i = m_index.find({file, end_version});
+        if (i == m_index.end())
+            return nullptr;
+        m_entries.splice(m_entries.begin(), m_entries, i->second); // Mark as most recently used
+        return i->second->second;
+    }
+
+    // Returns false if the entry was too big to be cached.
+    bool add(const ServerFile* file, Entry entry)
+    {
+        std::size_t size = entry->body_size();
+        if (size > m_max_size)
+            return false;
+        Key key{file, entry->end_version};
+        REALM_ASSERT(m_index.count(key) == 0);
+        m_entries.emplace_front(key, std::move(entry)); // Throws
+        try {
+            m_index[key] = m_entries.begin(); // Throws
+        }
+        catch (...) {
+            m_entries.pop_front();
+            throw;
+        }
+        m_size += size;
+        while (m_size > m_max_size)
+            evict(std::prev(m_entries.end()));
+        return true;
+    }
+
+    // Discard the cached bodies of all versions of the specified file.
+    void discard(const ServerFile* file) noexcept
+    {
+        auto i = m_index.lower_bound({file, 0});
+        while (i != m_index.end() && i->first.first == file) {
+            auto j = i->second;
+            ++i;
+            evict(j);
+        }
+    }
+
+    std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+private:
+    using Key = std::pair<const ServerFile*, version_type>;
+    using List = std::list<std::pair<Key, Entry>>;
+
+    const std::size_t m_max_size;
+    std::size_t m_size = 0;
+    List m_entries; // Most recently used first
+    std::map<Key, List::iterator> m_index;
+
+    void evict(List::iterator i) noexcept
+    {
+        m_size -= i->second->body_size();
+        m_index.erase(i->first);
+        m_entries.erase(i);
+    }
 };
 
 
@@ -431,8 +518,8 @@ public:
     // Logger to be used by the worker thread
     util::PrefixLogger wlogger;
 
-    ServerFile(ServerImpl& server, ServerFileAccessCache& cache, const std::string& virt_path, std::string real_path,
-               bool disable_sync_to_disk);
+    ServerFile(ServerImpl& server, ServerFileAccessCache& cache, Worker& worker, const std::string& virt_path,
+               std::string real_path, bool disable_sync_to_disk);
     ~ServerFile() noexcept;
 
     void initialize();
@@ -478,8 +565,6 @@ public:
         return m_version_info.sync_version;
     }
 
-    DownloadCache& get_download_cache() noexcept;
-
     void register_client_access(file_ident_type client_file_ident);
 
     using file_ident_request_type = std::int_fast64_t;
@@ -539,6 +624,10 @@ private:
     ServerImpl& m_server;
     ServerFileAccessCache::Slot m_file;
 
+    // The worker that all work on this file is passed to. It never changes, so
+    // work units for this file are never executed concurrently.
+    Worker& m_worker;
+
     // In general, `m_version_info` refers to the last snapshot of the Realm
     // file that is supposed to be visible to remote peers engaging in regular
     // Realm file synchronization.
@@ -648,8 +737,6 @@ private:
 
     std::vector<std::int_fast64_t> m_deleting_connections;
 
-    DownloadCache m_download_cache;
-
     void on_changesets_from_downstream_added(std::size_t num_changesets, std::size_t num_bytes);
     void on_work_added();
     void group_unblock_work();
@@ -675,11 +762,6 @@ private:
 };
 
 
-inline DownloadCache& ServerFile::get_download_cache() noexcept
-{
-    return m_download_cache;
-}
-
 inline void ServerFile::group_finalize_work_stage_1()
 {
     finalize_work_stage_1(); // Throws
@@ -694,11 +776,17 @@ inline void ServerFile::group_finalize_work_stage_2()
 // ============================ Worker ============================
 
 // All write transaction on server-side Realm files performed on behalf of the
-// server, must be performed by the worker thread, not the network event loop
+// server, must be performed by a worker thread, not the network event loop
 // thread. This is to ensure that the network event loop thread never gets
-// blocked waiting for the worker thread to end a long running write
+// blocked waiting for a worker thread to end a long running write
 // transaction.
 //
+// There are `Server::Config::num_workers` workers, each running on its own
+// thread. Every file is assigned to one of them (see
+// ServerImpl::get_worker_for()), and a worker only ever opens the files
+// assigned to it, so the workers share no state other than the server object
+// itself.
+//
 // FIXME: Currently, the event loop thread does perform a number of write
 // transactions, but only on subtier nodes of a star topology server cluster.
 class Worker : public ServerHistory::Context {
@@ -706,7 +794,7 @@ public:
     std::shared_ptr<util::Logger> logger_ptr;
     util::Logger& logger;
 
-    explicit Worker(ServerImpl&);
+    Worker(ServerImpl&, std::string logger_prefix);
 
     ServerFileAccessCache& get_file_access_cache() noexcept;
 
@@ -714,6 +802,7 @@ public:
 
     // Overriding members of ServerHistory::Context
     std::mt19937_64& server_history_get_random() noexcept override final;
+    std::size_t server_history_get_compaction_window() const noexcept override final;
 
 private:
     ServerImpl& m_server;
@@ -751,6 +840,10 @@ public:
     std::atomic<milliseconds_type> m_par_time;
     std::atomic<milliseconds_type> m_seq_time;
 
+    std::atomic<std::uint_fast64_t> m_num_compacted_history_entries = 0;
+    std::atomic<std::uint_fast64_t> m_num_bytes_saved_by_compaction = 0;
+    std::atomic<std::uint_fast64_t> m_compaction_time_us = 0; // Microseconds
+
     util::Mutex last_client_accesses_mutex;
 
     const std::shared_ptr<util::Logger> logger_ptr;
@@ -816,6 +909,11 @@ public:
         return m_misc_buffers;
     }
 
+    DownloadCache& get_download_cache() noexcept
+    {
+        return m_download_cache;
+    }
+
     int_fast64_t get_current_server_session_ident() const noexcept
     {
         return m_current_server_session_ident;
@@ -826,9 +924,11 @@ public:
         return m_scratch_memory;
     }
 
-    Worker& get_worker() noexcept
+    // Returns the worker that the specified file is assigned to.
+    Worker& get_worker_for(const std::string& virt_path) noexcept
     {
-        return m_worker;
+        std::size_t i = std::hash<std::string>{}(virt_path) % m_workers.size();
+        return *m_workers[i];
     }
 
     void get_workunit_timers(milliseconds_type& parallel_section, milliseconds_type& sequential_section)
@@ -837,6 +937,14 @@ public:
         sequential_section = m_seq_time;
     }
 
+    void get_history_compaction_counters(std::uint_fast64_t& num_entries, std::uint_fast64_t& num_bytes_saved,
+                                         milliseconds_type& time)
+    {
+        num_entries = m_num_compacted_history_entries;
+        num_bytes_saved = m_num_bytes_saved_by_compaction;
+        time = milliseconds_type(m_compaction_time_us / 1000);
+    }
+
     ServerImpl(const std::string& root_dir, util::Optional<sync::PKey>, Server::Config);
     ~ServerImpl() noexcept;
 
@@ -899,8 +1007,8 @@ public:
         m_realm_names.insert(virt_path);         // Throws
         {
             bool disable_sync_to_disk = m_config.disable_sync_to_disk;
-            file.reset(new ServerFile(*this, m_file_access_cache, virt_path, virt_path_components.real_realm_path,
-                                      disable_sync_to_disk)); // Throws
+            file.reset(new ServerFile(*this, m_file_access_cache, get_worker_for(virt_path), virt_path,
+                                      virt_path_components.real_realm_path, disable_sync_to_disk)); // Throws
         }
 
         file->initialize();
@@ -972,6 +1080,7 @@ public:
 
     // Overriding member functions in _impl::ServerHistory::Context
     std::mt19937_64& server_history_get_random() noexcept override final;
+    std::size_t server_history_get_compaction_window() const noexcept override final;
 
 private:
     Server::Config m_config;
@@ -997,7 +1106,7 @@ private:
 
     std::unique_ptr<network::ssl::Context> m_ssl_context;
     ServerFileAccessCache m_file_access_cache;
-    Worker m_worker;
+    std::vector<std::unique_ptr<Worker>> m_workers;
     std::map<std::string, util::bind_ptr<ServerFile>> m_files; // Key is virtual path
     network::Acceptor m_acceptor;
     std::int_fast64_t m_next_conn_id = 0;
@@ -1008,6 +1117,7 @@ private:
     ServerProtocol m_server_protocol;
     compression::CompressMemoryArena m_compress_memory_arena;
     MiscBuffers m_misc_buffers;
+    DownloadCache m_download_cache;
     int_fast64_t m_current_server_session_ident;
     Optional<network::DeadlineTimer> m_connection_reaper_timer;
     bool m_allow_load_balancing = false;
@@ -1264,12 +1374,21 @@ public:
     }
 
     // More advanced memory strategies can be implemented if needed.
-    void release_output_buffer() {}
+    void release_output_buffer() noexcept
+    {
+        m_output_body.reset();
+    }
 
     // When this function is called, the connection will initiate a write with
     // its output_buffer. Sessions use this method.
     void initiate_write_output_buffer();
 
+    // Same as initiate_write_output_buffer(), except that the specified body
+    // is sent as part of the same message, immediately after the contents of
+    // the output buffer. The body is sent without being copied, and is kept
+    // alive until the write completes.
+    void initiate_write_output_buffer(std::shared_ptr<const char> body, std::size_t body_size);
+
     void initiate_pong_output_buffer();
 
     void handle_protocol_error(Status status);
@@ -1313,6 +1432,7 @@ private:
     websocket::Socket m_websocket;
     std::unique_ptr<char[]> m_input_body_buffer;
     OutputBuffer m_output_buffer;
+    std::shared_ptr<const char> m_output_body;
     std::map<session_ident_type, std::unique_ptr<Session>> m_sessions;
 
     // The protocol version in use by the connected client.
@@ -2871,27 +2991,32 @@ private:
             ServerProtocol& protocol = get_server_protocol();
             bool enable_cache = (config.enable_download_bootstrap_cache && m_download_progress.server_version == 0 &&
                                  m_upload_progress.client_version == 0 && m_upload_threshold.client_version == 0);
-            DownloadCache& cache = m_server_file->get_download_cache();
-            bool fetch_from_cache = (enable_cache && cache.body && end_version == cache.end_version);
-            if (fetch_from_cache) {
-                body = cache.body.get();
-                uncompressed_body_size = cache.uncompressed_body_size;
-                compressed_body_size = cache.compressed_body_size;
-                body_is_compressed = cache.body_is_compressed;
-                download_progress = cache.download_progress;
-                downloadable_bytes = cache.downloadable_bytes;
-                num_changesets = cache.num_changesets;
-                accum_original_size = cache.accum_original_size;
-                accum_compacted_size = cache.accum_compacted_size;
+            DownloadCache& cache = server.get_download_cache();
+            DownloadCache::Entry cached;
+            if (enable_cache) {
+                cached = cache.get(m_server_file.get(), end_version);
+                if (cached) {
+                    logger.debug("Using cached bootstrap download for server version %1", end_version); // Throws
+                }
+                else {
+                    // Discard the cached DOWNLOAD bodies for older versions of
+                    // this file before generating a new one to be cached. They
+                    // will not be used again, and their size can be very large
+                    // (10GiB has been seen in a real-world case).
+                    cache.discard(m_server_file.get());
+                }
+            }
+            if (cached) {
+                uncompressed_body_size = cached->uncompressed_body_size;
+                compressed_body_size = cached->compressed_body_size;
+                body_is_compressed = cached->body_is_compressed;
+                download_progress = cached->download_progress;
+                downloadable_bytes = cached->downloadable_bytes;
+                num_changesets = cached->num_changesets;
+                accum_original_size = cached->accum_original_size;
+                accum_compacted_size = cached->accum_compacted_size;
             }
             else {
-                // Discard the old cached DOWNLOAD body before generating a new
-                // one to be cached. This can make a big difference because the
-                // size of that body can be very large (10GiB has been seen in a
-                // real-world case).
-                if (enable_cache)
-                    cache.body = {};
-
                 OutputBuffer& out = server.get_misc_buffers().download_message;
                 out.reset();
                 download_progress = m_download_progress;
@@ -2942,18 +3067,24 @@ private:
                         return;
                     }
                     REALM_ASSERT(upload_progress.client_version == 0);
+                    auto entry = std::make_shared<DownloadCacheEntry>(); // Throws
                     std::size_t body_size = (body_is_compressed ? compressed_body_size : uncompressed_body_size);
-                    cache.body = std::make_unique<char[]>(body_size); // Throws
-                    std::copy(body, body + body_size, cache.body.get());
-                    cache.uncompressed_body_size = uncompressed_body_size;
-                    cache.compressed_body_size = compressed_body_size;
-                    cache.body_is_compressed = body_is_compressed;
-                    cache.end_version = end_version;
-                    cache.download_progress = download_progress;
-                    cache.downloadable_bytes = downloadable_bytes;
-                    cache.num_changesets = num_changesets;
-                    cache.accum_original_size = accum_original_size;
-                    cache.accum_compacted_size = accum_compacted_size;
+                    entry->body = std::make_unique<char[]>(body_size); // Throws
+                    std::copy(body, body + body_size, entry->body.get());
+                    entry->uncompressed_body_size = uncompressed_body_size;
+                    entry->compressed_body_size = compressed_body_size;
+                    entry->body_is_compressed = body_is_compressed;
+                    entry->end_version = end_version;
+                    entry->download_progress = download_progress;
+                    entry->downloadable_bytes = downloadable_bytes;
+                    entry->num_changesets = num_changesets;
+                    entry->accum_original_size = accum_original_size;
+                    entry->accum_compacted_size = accum_compacted_size;
+                    cached = std::move(entry);
+                    if (!cache.add(m_server_file.get(), cached)) { // Throws
+                        logger.debug("Bootstrap download of %1 bytes is too big to be cached",
+                                     body_size); // Throws
+                    }
                 }
                 else {
                     std::size_t max_download_size = config.max_download_size;
@@ -2966,17 +3097,30 @@ private:
             }
 
             OutputBuffer& out = m_connection.get_output_buffer();
-            protocol.make_download_message(
-                m_connection.get_client_protocol_version(), out, m_session_ident, download_progress.server_version,
-                download_progress.last_integrated_client_version, last_server_version.version,
-                last_server_version.salt, upload_progress.client_version,
-                upload_progress.last_integrated_server_version, downloadable_bytes, num_changesets, body,
-                uncompressed_body_size, compressed_body_size, body_is_compressed, logger); // Throws
+            if (cached) {
+                // The cached body is shared by all the sessions that bootstrap
+                // from this server version, so it is sent directly from the
+                // cache rather than being copied into the output buffer.
+                protocol.make_download_message_header(
+                    m_connection.get_client_protocol_version(), out, m_session_ident,
+                    download_progress.server_version, download_progress.last_integrated_client_version,
+                    last_server_version.version, last_server_version.salt, upload_progress.client_version,
+                    upload_progress.last_integrated_server_version, downloadable_bytes, num_changesets,
+                    uncompressed_body_size, compressed_body_size, body_is_compressed, logger); // Throws
+            }
+            else {
+                protocol.make_download_message(
+                    m_connection.get_client_protocol_version(), out, m_session_ident,
+                    download_progress.server_version, download_progress.last_integrated_client_version,
+                    last_server_version.version, last_server_version.salt, upload_progress.client_version,
+                    upload_progress.last_integrated_server_version, downloadable_bytes, num_changesets, body,
+                    uncompressed_body_size, compressed_body_size, body_is_compressed, logger); // Throws
+            }
 
             m_download_progress = download_progress;
             logger.debug("Setting of m_download_progress.server_version = %1",
                          m_download_progress.server_version); // Throws
-            send_download_message();
+            send_download_message(std::move(cached));
             m_one_download_message_sent = true;
 
             enlist_to_send();
@@ -3020,8 +3164,14 @@ private:
         // Protocol state is now WaitForStateRequest or WaitForIdent
     }
 
-    void send_download_message()
+    void send_download_message(DownloadCache::Entry cached)
     {
+        if (cached) {
+            std::size_t body_size = cached->body_size();
+            std::shared_ptr<const char> body{cached, cached->body.get()};
+            m_connection.initiate_write_output_buffer(std::move(body), body_size); // Throws
+            return;
+        }
         m_connection.initiate_write_output_buffer(); // Throws
     }
 
@@ -3187,13 +3337,14 @@ void SessionQueue::clear() noexcept
 
 // ============================ ServerFile implementation ============================
 
-ServerFile::ServerFile(ServerImpl& server, ServerFileAccessCache& cache, const std::string& virt_path,
+ServerFile::ServerFile(ServerImpl& server, ServerFileAccessCache& cache, Worker& worker, const std::string& virt_path,
                        std::string real_path, bool disable_sync_to_disk)
-    : logger{util::LogCategory::server, "ServerFile[" + virt_path + "]: ", server.logger_ptr}               // Throws
-    , wlogger{util::LogCategory::server, "ServerFile[" + virt_path + "]: ", server.get_worker().logger_ptr} // Throws
+    : logger{util::LogCategory::server, "ServerFile[" + virt_path + "]: ", server.logger_ptr}  // Throws
+    , wlogger{util::LogCategory::server, "ServerFile[" + virt_path + "]: ", worker.logger_ptr} // Throws
     , m_server{server}
     , m_file{cache, real_path, virt_path, false, disable_sync_to_disk} // Throws
-    , m_worker_file{server.get_worker().get_file_access_cache(), real_path, virt_path, true, disable_sync_to_disk}
+    , m_worker{worker}
+    , m_worker_file{worker.get_file_access_cache(), real_path, virt_path, true, disable_sync_to_disk}
 {
 }
 
@@ -3455,8 +3606,7 @@ void ServerFile::group_unblock_work()
         if (REALM_LIKELY(work.has_primary_work)) {
             logger.trace("Work unit unblocked"); // Throws
             m_has_work_in_progress = true;
-            Worker& worker = m_server.get_worker();
-            worker.enqueue(this); // Throws
+            m_worker.enqueue(this); // Throws
         }
     }
 }
@@ -3570,6 +3720,17 @@ bool ServerFile::worker_integrate_changes_from_downstream(WorkerState& state)
     bool produced_new_realm_version = hist.integrate_client_changesets(
         m_work.changesets_from_downstream, m_work.version_info, backup_whole_realm, m_work.integration_result,
         wlogger); // Throws
+    const ServerHistory::IntegrationResult& result = m_work.integration_result;
+    if (result.num_compacted_history_entries > 0) {
+        wlogger.debug("Compacted %1 history entries, saving %2 bytes", result.num_compacted_history_entries,
+                      result.num_bytes_saved_by_compaction); // Throws
+        m_server.m_num_compacted_history_entries.fetch_add(result.num_compacted_history_entries,
+                                                           std::memory_order_relaxed);
+        m_server.m_num_bytes_saved_by_compaction.fetch_add(result.num_bytes_saved_by_compaction,
+                                                           std::memory_order_relaxed);
+        m_server.m_compaction_time_us.fetch_add(std::uint_fast64_t(result.compaction_time.count()),
+                                                std::memory_order_relaxed);
+    }
     bool produced_new_sync_version = !m_work.integration_result.integrated_changesets.empty();
     REALM_ASSERT(!produced_new_sync_version || produced_new_realm_version);
     if (produced_new_realm_version) {
@@ -3724,9 +3885,9 @@ void ServerFile::finalize_work_stage_2()
 
 // ============================ Worker implementation ============================
 
-Worker::Worker(ServerImpl& server)
-    : logger_ptr{std::make_shared<util::PrefixLogger>(util::LogCategory::server, "Worker: ", server.logger_ptr)}
-    // Throws
+Worker::Worker(ServerImpl& server, std::string logger_prefix)
+    : logger_ptr{std::make_shared<util::PrefixLogger>(util::LogCategory::server, std::move(logger_prefix),
+                                                      server.logger_ptr)} // Throws
     , logger(*logger_ptr)
     , m_server{server}
     , m_file_access_cache{server.get_config().max_open_files, logger, *this, server.get_config().encryption_key}
@@ -3749,6 +3910,12 @@ std::mt19937_64& Worker::server_history_get_random() noexcept
 }
 
 
+std::size_t Worker::server_history_get_compaction_window() const noexcept
+{
+    return m_server.get_config().history_compaction_window;
+}
+
+
 void Worker::run()
 {
     for (;;) {
@@ -3790,11 +3957,16 @@ ServerImpl::ServerImpl(const std::string& root_dir, util::Optional<sync::PKey> p
     , m_access_control{std::move(pkey)}
     , m_protocol_version_range{determine_protocol_version_range(config)}                 // Throws
     , m_file_access_cache{m_config.max_open_files, logger, *this, config.encryption_key} // Throws
-    , m_worker{*this}                                                                    // Throws
     , m_acceptor{get_service()}
     , m_server_protocol{}       // Throws
     , m_compress_memory_arena{} // Throws
+    , m_download_cache{m_config.download_bootstrap_cache_size}
 {
+    int num_workers = std::max(m_config.num_workers, 1);
+    for (int i = 0; i < num_workers; ++i) {
+        std::string logger_prefix = (num_workers == 1 ? "Worker: " : util::format("Worker[%1]: ", i + 1));
+        m_workers.push_back(std::make_unique<Worker>(*this, std::move(logger_prefix))); // Throws
+    }
     if (m_config.ssl) {
         m_ssl_context = std::make_unique<network::ssl::Context>();                // Throws
         m_ssl_context->use_certificate_chain_file(m_config.ssl_certificate_path); // Throws
@@ -3837,6 +4009,7 @@ void ServerImpl::start()
     }
     logger.info("Directory holding persistent state: %1", m_root_dir);        // Throws
     logger.info("Maximum number of open files: %1", m_config.max_open_files); // Throws
+    logger.info("Number of workers: %1", m_workers.size());                   // Throws
     {
         const char* lead_text = "Encryption";
         if (m_config.encryption_key) {
@@ -3861,8 +4034,12 @@ void ServerImpl::start()
                     "never do this in production!"); // Throws
     }
     logger.info("Download bootstrap caching: %1",
-                (m_config.enable_download_bootstrap_cache ? "Yes" : "No"));                // Throws
+                (m_config.enable_download_bootstrap_cache ? "Yes" : "No")); // Throws
+    if (m_config.enable_download_bootstrap_cache) {
+        logger.info("Download bootstrap cache size: %1 bytes", m_config.download_bootstrap_cache_size); // Throws
+    }
     logger.info("Max download size: %1 bytes", m_config.max_download_size);                // Throws
+    logger.info("History compaction window: %1 entries", m_config.history_compaction_window); // Throws
     logger.info("Max upload backlog: %1 bytes", m_max_upload_backlog);                     // Throws
     logger.info("HTTP request timeout: %1 ms", m_config.http_request_timeout);             // Throws
     logger.info("HTTP response timeout: %1 ms", m_config.http_response_timeout);           // Throws
@@ -3884,19 +4061,27 @@ void ServerImpl::run()
     auto ta = util::make_temp_assign(m_running, true);
 
     {
-        auto worker_thread = util::make_thread_exec_guard(m_worker, *this); // Throws
+        std::vector<util::ThreadExecGuardWithParent<Worker, ServerImpl>> worker_threads;
+        worker_threads.reserve(m_workers.size()); // Throws
         std::string name;
-        if (util::Thread::get_name(name)) {
-            name += "-worker";
-            worker_thread.start_with_signals_blocked(name); // Throws
-        }
-        else {
-            worker_thread.start_with_signals_blocked(); // Throws
+        bool has_name = util::Thread::get_name(name);
+        for (std::size_t i = 0; i < m_workers.size(); ++i) {
+            auto& worker_thread = worker_threads.emplace_back(*m_workers[i], *this); // Throws
+            if (has_name) {
+                std::string worker_name = name + "-worker";
+                if (m_workers.size() > 1)
+                    worker_name += "-" + std::to_string(i + 1);
+                worker_thread.start_with_signals_blocked(worker_name); // Throws
+            }
+            else {
+                worker_thread.start_with_signals_blocked(); // Throws
+            }
         }
 
         m_service.run(); // Throws
 
-        worker_thread.stop_and_rethrow(); // Throws
+        for (auto& worker_thread : worker_threads)
+            worker_thread.stop_and_rethrow(); // Throws
     }
 
     logger.info("Realm sync server stopped");
@@ -3941,6 +4126,12 @@ std::mt19937_64& ServerImpl::server_history_get_random() noexcept
 }
 
 
+std::size_t ServerImpl::server_history_get_compaction_window() const noexcept
+{
+    return m_config.history_compaction_window;
+}
+
+
 void ServerImpl::listen()
 {
     network::Resolver resolver{get_service()};
@@ -4543,6 +4734,21 @@ void SyncConnection::initiate_write_output_buffer()
 }
 
 
+void SyncConnection::initiate_write_output_buffer(std::shared_ptr<const char> body, std::size_t body_size)
+{
+    auto handler = [this](std::error_code ec, size_t) {
+        if (!ec) {
+            handle_write_output_buffer();
+        }
+    };
+
+    m_output_body = std::move(body);
+    m_websocket.async_write_binary(m_output_buffer.data(), m_output_buffer.size(), m_output_body.get(), body_size,
+                                   std::move(handler)); // Throws
+    m_is_sending = true;
+}
+
+
 void SyncConnection::initiate_pong_output_buffer()
 {
     auto handler = [this](std::error_code ec, size_t) {
@@ -4842,3 +5048,10 @@ void Server::get_workunit_timers(milliseconds_type& parallel_section, millisecon
 {
     m_impl->get_workunit_timers(parallel_section, sequential_section);
 }
+
+
+void Server::get_history_compaction_counters(std::uint_fast64_t& num_entries, std::uint_fast64_t& num_bytes_saved,
+                                             milliseconds_type& time)
+{
+    m_impl->get_history_compaction_counters(num_entries, num_bytes_saved, time);
+}
@@ -70,12 +70,22 @@ public:
         Config() {}
 
         /// The maximum number of Realm files that will be kept open
-        /// concurrently by each major thread inside the server. The server
-        /// currently has two major threads (foreground and background). The
-        /// server keeps a cache of open Realm files for efficiency reasons (one
-        /// for each major thread).
+        /// concurrently by each major thread inside the server. The major
+        /// threads are the network event loop thread (foreground) and the
+        /// worker threads (background, see \ref num_workers). The server keeps
+        /// a cache of open Realm files for efficiency reasons (one for each
+        /// major thread).
         long max_open_files = 256;
 
+        /// The number of worker threads that integrate changesets uploaded by
+        /// clients. Each Realm file is assigned to one of the workers based on
+        /// its virtual path, and all work on that file is done by that worker,
+        /// so changes to different files can be integrated concurrently. Each
+        /// worker has its own cache of open Realm files.
+        ///
+        /// The network event loop still runs on a single thread.
+        int num_workers = 1;
+
         /// An optional custom clock to be used for token expiration checks. If
         /// no clock is specified, the server will use the system clock.
         Clock* token_expiration_clock = nullptr;
@@ -163,9 +173,18 @@ public:
         milliseconds_type soft_close_timeout = default_soft_close_timeout;
 
         /// If set to true, the server will cache the contents of the DOWNLOAD
-        /// message(s) used for client bootstrapping.
+        /// message(s) used for client bootstrapping. The cached contents are
+        /// shared by all clients that bootstrap from the same server version
+        /// of a file, and are sent to them without being copied.
         bool enable_download_bootstrap_cache = false;
 
+        /// The maximum accumulated size in bytes of the DOWNLOAD message
+        /// contents kept by the download bootstrap cache (see
+        /// `enable_download_bootstrap_cache`). When exceeded, the least
+        /// recently used contents are discarded. Contents that are larger than
+        /// this on their own are not cached.
+        std::size_t download_bootstrap_cache_size = 0x40000000; // 1 GiB
+
         /// The accumulated size of changesets that are included in download
         /// messages. The size of the changesets is calculated before log
         /// compaction (if enabled). A larger value leads to more efficient
@@ -174,6 +193,17 @@ public:
         /// for the need to resend the same changes after network disconnects.
         std::size_t max_download_size = 0x1000000; // 16 MiB
 
+        /// The maximum number of history entries whose changesets are
+        /// compacted as part of each transaction that integrates changes
+        /// uploaded by clients. Compaction removes instructions that are
+        /// overwritten by later instructions of the same changeset. It works
+        /// its way through the history from the oldest entry, a bounded number
+        /// of entries at a time, so it never holds up integration for long.
+        /// The progress is stored in the history, so compaction resumes where
+        /// it left off when the server is restarted. Set to zero to disable
+        /// history compaction.
+        std::size_t history_compaction_window = 64;
+
         /// The maximum number of connections that can be queued up waiting to
         /// be accepted by the server. This corresponds to the `backlog`
         /// argument of the `listen()` function as described by POSIX.
@@ -350,6 +380,12 @@ public:
     /// of the server.
     void get_workunit_timers(milliseconds_type& parallel_section, milliseconds_type& sequential_section);
 
+    /// Get the accumulated number of history entries compacted since start of
+    /// the server (see Config::history_compaction_window), the number of bytes
+    /// by which their changesets shrank, and the time spent compacting them.
+    void get_history_compaction_counters(std::uint_fast64_t& num_entries, std::uint_fast64_t& num_bytes_saved,
+                                         milliseconds_type& time);
+
 private:
     class Implementation;
     std::unique_ptr<Implementation> m_impl;
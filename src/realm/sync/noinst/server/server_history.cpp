@@ -1,6 +1,8 @@
 #include <algorithm>
 #include <cstring>
+#include <set>
 #include <stack>
+#include <tuple>
 
 #include <realm/sync/changeset_encoder.hpp>
 #include <realm/sync/changeset_parser.hpp>
@@ -225,6 +227,68 @@ namespace {
 constexpr ServerHistory::file_ident_type g_root_node_file_ident = 1;
 
 
+// Remove the instructions of the specified changeset whose effect is
+// overwritten by a later instruction of the same changeset. These are updates
+// of, and integer additions to a property of an object, followed by a
+// nondefault update of the same property of the same object, without any
+// intervening collection operations on the property, creation or erasure of
+// the object, or schema changes. All instructions of a changeset are merged
+// with the same timestamp, so the later update always prevails over whatever
+// the removed instructions could be merged with, and the outcome of merging is
+// not affected. Returns the number of removed instructions.
+std::size_t compact_changeset(Changeset& changeset)
+{
+    using Instruction = sync::Instruction;
+    using Key = std::tuple<InternString, Instruction::PrimaryKey, InternString>;
+    std::set<Key> overwritten;
+    std::vector<Changeset::iterator> positions;
+    for (auto i = changeset.begin(); i != changeset.end(); ++i)
+        positions.push_back(i); // Throws
+
+    std::size_t num_removed = 0;
+    for (auto i = positions.rbegin(); i != positions.rend(); ++i) {
+        Instruction* instr = **i;
+        if (!instr)
+            continue;
+        bool redundant = instr->visit([&](auto& instr_2) {
+            using T = std::decay_t<decltype(instr_2)>;
+            if constexpr (std::is_same_v<T, Instruction::Update> || std::is_same_v<T, Instruction::AddInteger>) {
+                if (instr_2.path.size() == 0) {
+                    Key key{instr_2.table, instr_2.object, instr_2.field};
+                    if (overwritten.count(key) != 0)
+                        return true;
+                    if constexpr (std::is_same_v<T, Instruction::Update>) {
+                        if (!instr_2.is_default)
+                            overwritten.insert(std::move(key)); // Throws
+                    }
+                    return false;
+                }
+            }
+            if constexpr (std::is_base_of_v<Instruction::PathInstruction, T>) {
+                overwritten.erase({instr_2.table, instr_2.object, instr_2.field});
+            }
+            else if constexpr (std::is_base_of_v<Instruction::ObjectInstruction, T>) {
+                auto begin = overwritten.lower_bound({instr_2.table, instr_2.object, InternString{0}});
+                auto end = begin;
+                while (end != overwritten.end() && std::get<0>(*end) == instr_2.table &&
+                       std::get<1>(*end) == instr_2.object)
+                    ++end;
+                overwritten.erase(begin, end);
+            }
+            else {
+                overwritten.clear();
+            }
+            return false;
+        });
+        if (redundant) {
+            changeset.erase_stable(*i);
+            ++num_removed;
+        }
+    }
+    return num_removed;
+}
+
+
 } // unnamed namespace
 
 
@@ -417,6 +481,9 @@ bool ServerHistory::integrate_client_changesets(const IntegratableChangesets& in
             }
 
             if (dirty) {
+                std::size_t compaction_window = m_context.server_history_get_compaction_window();
+                if (compaction_window > 0)
+                    compact_history(compaction_window, result); // Throws
                 auto ta = util::make_temp_assign(m_is_local_changeset, false, true);
                 version_info.realm_version = tr->commit(); // Throws
                 version_info.sync_version = get_salted_server_version();
@@ -1896,6 +1963,61 @@ void ServerHistory::add_sync_history_entry(const HistoryEntry& entry)
 }
 
 
+// Compacts the changesets of at most `max_num_entries` history entries,
+// starting after `compacted_until_version`, which is then advanced past them.
+// Doing this in bounded steps as part of the integration transactions keeps
+// the amount of work per transaction small, and since the progress is stored in
+// the history, it resumes where it left off if the server is restarted.
+//
+// The cumulative byte sizes of the history entries are not changed, so the
+// download progress reported to clients refers to the uncompacted sizes.
+void ServerHistory::compact_history(std::size_t max_num_entries, IntegrationResult& result)
+{
+    // Must be in write transaction!
+
+    auto start_time = std::chrono::steady_clock::now();
+    version_type begin_version =
+        version_type(m_acc->root.get_as_ref_or_tagged(s_compacted_until_version_iip).get_as_int());
+    begin_version = std::max(begin_version, m_history_base_version);
+    version_type end_version = get_server_version();
+    if (end_version - begin_version > max_num_entries)
+        end_version = begin_version + max_num_entries;
+    if (begin_version == end_version)
+        return;
+
+    std::size_t num_bytes_saved = 0;
+    for (version_type version = begin_version + 1; version <= end_version; ++version) {
+        std::size_t history_entry_ndx = std::size_t(version - m_history_base_version - 1);
+        ChunkedBinaryData chunked_changeset{m_acc->sh_changesets, history_entry_ndx};
+        std::size_t orig_size = chunked_changeset.size();
+        if (orig_size == 0)
+            continue;
+        Changeset changeset;
+        ChunkedBinaryInputStream in{chunked_changeset};
+        parse_changeset(in, changeset); // Throws
+        if (compact_changeset(changeset) == 0) // Throws
+            continue;
+        ChangesetEncoder::Buffer buffer;
+        encode_changeset(changeset, buffer); // Throws
+        if (buffer.size() >= orig_size)
+            continue;
+        m_acc->sh_changesets.set(history_entry_ndx, BinaryData{buffer.data(), buffer.size()}); // Throws
+        num_bytes_saved += orig_size - buffer.size();
+    }
+
+    auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch());
+    m_acc->root.set(s_compacted_until_version_iip, RefOrTagged::make_tagged(end_version)); // Throws
+    m_acc->root.set(s_last_compaction_timestamp_iip,
+                    RefOrTagged::make_tagged(std::uint_fast64_t(timestamp.count()))); // Throws
+
+    result.num_compacted_history_entries += std::size_t(end_version - begin_version);
+    result.num_bytes_saved_by_compaction += num_bytes_saved;
+    result.compaction_time += std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start_time);
+}
+
+
 void ServerHistory::trim_cont_transact_history()
 {
     REALM_ASSERT(m_acc->ct_history.size() == m_ct_history_size);
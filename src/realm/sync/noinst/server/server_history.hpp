@@ -2,6 +2,7 @@
 #ifndef REALM_NOINST_SERVER_HISTORY_HPP
 #define REALM_NOINST_SERVER_HISTORY_HPP
 
+#include <chrono>
 #include <cstdint>
 #include <ctime>
 #include <random>
@@ -207,6 +208,12 @@ public:
 
         std::vector<const IntegratableChangeset*> integrated_changesets;
 
+        // The history entries that were compacted as part of the integration
+        // (see Context::server_history_get_compaction_window()).
+        std::size_t num_compacted_history_entries = 0;
+        std::size_t num_bytes_saved_by_compaction = 0;
+        std::chrono::microseconds compaction_time = {};
+
         void partial_clear() noexcept
         {
             integrated_changesets.clear();
@@ -667,6 +674,7 @@ private:
     bool is_valid_proxy_file_ident(file_ident_type) const noexcept;
     void add_core_history_entry(BinaryData);
     void add_sync_history_entry(const HistoryEntry&);
+    void compact_history(std::size_t max_num_entries, IntegrationResult&);
     void trim_cont_transact_history();
     ChunkedBinaryData get_changeset(version_type server_version) const noexcept;
     version_type find_history_entry(file_ident_type remote_file_ident, version_type begin_version,
@@ -736,6 +744,17 @@ class ServerHistory::Context {
 public:
     virtual std::mt19937_64& server_history_get_random() noexcept = 0;
 
+    /// The maximum number of history entries to be compacted as part of each
+    /// transaction that integrates changesets from clients. Compaction removes
+    /// instructions from the changeset of a history entry when their effect is
+    /// overwritten by a later instruction of the same changeset. It proceeds
+    /// from the oldest entry, and its progress is persisted as
+    /// `compacted_until_version`. Zero disables history compaction.
+    virtual std::size_t server_history_get_compaction_window() const noexcept
+    {
+        return 0;
+    }
+
 protected:
     Context() noexcept = default;
 };
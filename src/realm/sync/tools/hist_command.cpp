@@ -11,6 +11,7 @@
 #include <sstream>
 #include <iostream>
 
+#include <realm/array_blob.hpp>
 #include <realm/array_integer.hpp>
 #include <realm/util/compression.hpp>
 #include <realm/util/features.h>
@@ -481,6 +482,10 @@ public:
     virtual void print_info(std::ostream&) const = 0;
     virtual void print_annotated_info(std::ostream&, TimestampFormatter&) const = 0;
     virtual void get_changeset(util::AppendBuffer<char>&) const = 0;
+    virtual util::Span<const char> get_compression_dictionary() const
+    {
+        return {};
+    }
 };
 
 
@@ -796,13 +801,13 @@ public:
     ClientHistoryCursor(Allocator& alloc, ref_type root_ref, int schema_version,
                         version_type current_snapshot_version)
     {
-        REALM_ASSERT(schema_version == 12);
+        REALM_ASSERT(schema_version == 12 || schema_version == 13);
 
         if (root_ref == 0)
             return;
 
         // Size of fixed-size arrays
-        std::size_t root_size = 21;
+        std::size_t root_size = (schema_version < 13 ? 21 : 22);
 
         // Slots in root array of history compartment
         std::size_t changesets_iip = 13;
@@ -810,11 +815,19 @@ public:
         std::size_t remote_versions_iip = 15;
         std::size_t origin_file_idents_iip = 16;
         std::size_t origin_timestamps_iip = 17;
+        std::size_t compression_dictionary_iip = 21;
 
         Array root{alloc};
         root.init_from_ref(root_ref);
         if (root.size() != root_size)
             throw std::runtime_error("Unexpected size of root array of history compartment");
+        if (schema_version >= 13) {
+            if (ref_type ref = root.get_as_ref(compression_dictionary_iip)) {
+                ArrayBlob dictionary{alloc};
+                dictionary.init_from_ref(ref);
+                m_compression_dictionary.assign(dictionary.get(0), dictionary.size()); // Throws
+            }
+        }
         {
             ref_type ref = root.get_as_ref(changesets_iip);
             m_changesets.reset(new BinaryColumn(alloc)); // Throws
@@ -921,9 +934,15 @@ public:
         ::get_changeset(*m_changesets, index, buffer); // Throws
     }
 
+    util::Span<const char> get_compression_dictionary() const override final
+    {
+        return m_compression_dictionary;
+    }
+
 private:
     std::unique_ptr<BinaryColumn> m_changesets;
     std::unique_ptr<BinaryColumn> m_reciprocal_transforms;
+    std::string m_compression_dictionary;
     std::unique_ptr<IntegerBpTree> m_remote_versions;
     std::unique_ptr<IntegerBpTree> m_origin_file_idents;
     std::unique_ptr<IntegerBpTree> m_origin_timestamps;
@@ -1595,7 +1614,8 @@ void inspect_history(SyncHistoryCursor& cursor, util::Optional<file_ident_type>
             cursor.get_changeset(buffer); // Throws
             util::SimpleInputStream in{buffer};
             size_t decompressed_size;
-            auto decompressed = util::compression::decompress_nonportable_input_stream(in, decompressed_size);
+            auto decompressed = util::compression::decompress_nonportable_input_stream(
+                in, decompressed_size, cursor.get_compression_dictionary());
             sync::Changeset changeset;
             sync::parse_changeset(*decompressed, changeset); // Throws
             expression->reset(changeset);
@@ -1641,7 +1661,8 @@ void inspect_history(SyncHistoryCursor& cursor, util::Optional<file_ident_type>
                 cursor.get_changeset(buffer); // Throws
                 util::SimpleInputStream in{buffer};
                 size_t decompressed_size;
-                auto decompressed = util::compression::decompress_nonportable_input_stream(in, decompressed_size);
+                auto decompressed = util::compression::decompress_nonportable_input_stream(
+                    in, decompressed_size, cursor.get_compression_dictionary());
                 sync::Changeset changeset;
                 sync::parse_changeset(*decompressed, changeset); // Throws
 #if REALM_DEBUG
@@ -2263,7 +2284,7 @@ int main(int argc, char* argv[])
         int history_schema_version;
         gf::get_version_and_history_info(alloc, top_ref, version, history_type, history_schema_version);
         if (history_type == Replication::hist_SyncClient) {
-            if (history_schema_version == 12) {
+            if (history_schema_version == 12 || history_schema_version == 13) {
                 factory = std::make_unique<ClientCursorFactory>(alloc, history_ref, history_schema_version,
                                                                 version); // Throws
             }
@@ -4,6 +4,11 @@
 #include <realm/sync/noinst/changeset_index.hpp>
 #include <realm/sync/noinst/protocol_codec.hpp>
 
+#include <condition_variable>
+#include <deque>
+#include <numeric>
+#include <thread>
+
 #if REALM_DEBUG
 #include <sstream>
 #include <iostream> // std::cerr used for debug tracing
@@ -2376,6 +2381,340 @@ void TransformerImpl::merge_instructions(MajorSide& their_side, MinorSide& our_s
     }
 }
 
+
+// Threads which run the partitions of parallel merges that are not run on the
+// calling thread. The threads are started when first needed and are shared by
+// all merges in the process, so no threads are created for each merge. The
+// pool is never destroyed, as merges may run on other threads during exit.
+class MergeWorkerPool {
+public:
+    static MergeWorkerPool& get()
+    {
+        static MergeWorkerPool& pool = *new MergeWorkerPool;
+        return pool;
+    }
+
+    // Runs `task(0)` to `task(num_tasks - 1)` on the worker threads while the
+    // calling thread runs `local`, and returns once all of them have
+    // completed. The first exception thrown by any of them is rethrown. Tasks
+    // which no worker has started when `local` returns, because the workers
+    // are busy with other merges, are run on the calling thread.
+    void run(size_t num_tasks, util::FunctionRef<void(size_t)> task, util::FunctionRef<void()> local)
+    {
+        Job job{&task, num_tasks};
+        {
+            std::lock_guard lock(m_mutex);
+            while (m_threads.size() < num_tasks) {
+                m_threads.emplace_back([this] {
+                    worker_loop();
+                }); // Throws
+            }
+            m_jobs.push_back(&job); // Throws
+        }
+        m_work_cv.notify_all();
+
+        std::exception_ptr error;
+        try {
+            local();
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+
+        std::unique_lock lock(m_mutex);
+        while (job.next_task < job.num_tasks)
+            run_task(lock, job);
+        m_done_cv.wait(lock, [&] {
+            return job.num_completed == job.num_tasks;
+        });
+        lock.unlock();
+        if (!error)
+            error = job.error;
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+private:
+    struct Job {
+        const util::FunctionRef<void(size_t)>* task;
+        size_t num_tasks;
+        size_t next_task = 0;
+        size_t num_completed = 0;
+        std::exception_ptr error;
+    };
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_work_cv;
+    std::condition_variable m_done_cv;
+    // Jobs with tasks that have not been started yet.
+    std::deque<Job*> m_jobs;
+
+    // Runs the next task of `job`. `lock` must be locked on entry, and is
+    // locked again on return.
+    void run_task(std::unique_lock<std::mutex>& lock, Job& job)
+    {
+        size_t ndx = job.next_task++;
+        if (job.next_task == job.num_tasks)
+            m_jobs.erase(std::find(m_jobs.begin(), m_jobs.end(), &job));
+        lock.unlock();
+        std::exception_ptr error;
+        try {
+            (*job.task)(ndx);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        lock.lock();
+        if (error && !job.error)
+            job.error = error;
+        if (++job.num_completed == job.num_tasks)
+            m_done_cv.notify_all();
+    }
+
+    void worker_loop()
+    {
+        std::unique_lock lock(m_mutex);
+        for (;;) {
+            m_work_cv.wait(lock, [&] {
+                return !m_jobs.empty();
+            });
+            run_task(lock, *m_jobs.front());
+        }
+    }
+};
+
+// Parallel merge
+//
+// Instructions in different conflict groups never meet in the merge algorithm,
+// so as long as no schema changes are involved (which conflict with
+// everything), the merge can be split into independent sub-merges, one per set
+// of conflict groups. Each sub-merge operates on private copies of the
+// relevant instructions, which are then moved back into the slots they came
+// from, while the strings are read from the original changesets. Since
+// object-level merge rules neither intern strings nor prepend instructions,
+// and the relative order of the instructions within each conflict group is
+// preserved, the result is identical to that of the serial merge.
+class ParallelMerge {
+public:
+    ParallelMerge(_impl::ChangesetIndex& their_index, Span<Changeset> their_changesets,
+                  Span<Changeset*> our_changesets)
+        : m_their_index(their_index)
+        , m_their_changesets(their_changesets)
+        , m_our_changesets(our_changesets)
+    {
+    }
+
+    /// Assign the instructions to at most \a max_partitions partitions of
+    /// conflict groups. Returns false if the merge cannot be split into two or
+    /// more partitions, in which case the serial merge must be used.
+    bool partition(size_t max_partitions);
+
+    /// Transform the partitions concurrently, and move the results back into
+    /// the original changesets. If an exception is thrown, the original
+    /// changesets are left untouched.
+    void run(Logger&);
+
+private:
+    struct Group {
+        size_t num_ours = 0;
+        size_t num_theirs = 0;
+        size_t partition = 0;
+    };
+
+    struct Part {
+        // The changeset that slots were copied from, and whose strings are
+        // shared by `changeset`, and the index of the original slot of each
+        // instruction in `changeset`.
+        Changeset* original = nullptr;
+        Changeset changeset;
+        std::vector<size_t> slots;
+    };
+
+    struct Partition {
+        std::vector<Part> theirs;
+        std::vector<Part> ours;
+    };
+
+    struct Slot {
+        size_t changeset;
+        size_t slot;
+        size_t group;
+    };
+
+    _impl::ChangesetIndex& m_their_index;
+    Span<Changeset> m_their_changesets;
+    Span<Changeset*> m_our_changesets;
+    std::map<const _impl::ChangesetIndex::Ranges*, size_t> m_group_indexes;
+    std::vector<Group> m_groups;
+    std::vector<Slot> m_our_slots;
+    std::vector<Slot> m_their_slots;
+    std::vector<Partition> m_partitions;
+
+    void build_parts(std::vector<Slot>& slots, bool ours);
+    static void transform(Partition&);
+};
+
+bool ParallelMerge::partition(size_t max_partitions)
+{
+    if (max_partitions < 2 || m_their_index.get_num_conflict_groups() < 2)
+        return false;
+
+    // Find the conflict group of every local instruction. Instructions whose
+    // conflict group contains no incoming instructions are left alone, just
+    // like the serial merge would do.
+    for (size_t i = 0; i < m_our_changesets.size(); ++i) {
+        Changeset& changeset = *m_our_changesets[i];
+        auto first_slot = changeset.begin().m_inner;
+        for (auto it = changeset.begin(); it != changeset.end(); ++it) {
+            if (it.m_inner->size() > 1)
+                return false; // Holds prepended instructions
+            const Instruction* instr = *it;
+            if (!instr)
+                continue;
+            if (_impl::is_schema_change(*instr))
+                return false;
+            _impl::ChangesetIndex::GlobalID ids[2];
+            _impl::get_object_ids_in_instruction(changeset, *instr, ids, 2);
+            const auto* ranges = m_their_index.get_modifications_for_object(ids[0]);
+            if (ranges->empty())
+                continue;
+            auto [group_it, inserted] = m_group_indexes.emplace(ranges, m_groups.size());
+            if (inserted)
+                m_groups.emplace_back();
+            ++m_groups[group_it->second].num_ours;
+            m_our_slots.push_back({i, size_t(it.m_inner - first_slot), group_it->second});
+        }
+    }
+    if (m_groups.size() < 2)
+        return false;
+
+    for (auto& [ranges, group_index] : m_group_indexes) {
+        for (auto& [changeset, changeset_ranges] : *ranges) {
+            size_t changeset_index = size_t(changeset - m_their_changesets.data());
+            REALM_ASSERT(changeset_index < m_their_changesets.size());
+            auto first_slot = changeset->begin().m_inner;
+            for (auto& range : changeset_ranges) {
+                for (auto it = range.begin; it != range.end; ++it) {
+                    if (it.m_inner->size() > 1)
+                        return false;
+                    if (!*it)
+                        continue;
+                    ++m_groups[group_index].num_theirs;
+                    m_their_slots.push_back({changeset_index, size_t(it.m_inner - first_slot), group_index});
+                }
+            }
+        }
+    }
+
+    // Distribute the conflict groups over the partitions, heaviest first, each
+    // going to the partition with the least work so far. The cost of merging
+    // a conflict group is roughly proportional to the product of the number
+    // of instructions on either side.
+    auto cost = [&](size_t group_index) {
+        const Group& group = m_groups[group_index];
+        return group.num_ours * group.num_theirs + group.num_ours + group.num_theirs;
+    };
+    std::vector<size_t> order(m_groups.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return cost(a) > cost(b);
+    });
+    m_partitions.resize(std::min(max_partitions, m_groups.size()));
+    std::vector<size_t> load(m_partitions.size(), 0);
+    for (size_t group_index : order) {
+        auto least_loaded = std::min_element(load.begin(), load.end());
+        *least_loaded += cost(group_index);
+        m_groups[group_index].partition = size_t(least_loaded - load.begin());
+    }
+
+    build_parts(m_their_slots, false);
+    build_parts(m_our_slots, true);
+    return true;
+}
+
+void ParallelMerge::build_parts(std::vector<Slot>& slots, bool ours)
+{
+    // Keep the instructions in their original order within each changeset.
+    std::sort(slots.begin(), slots.end(), [](const Slot& a, const Slot& b) {
+        return std::tie(a.changeset, a.slot) < std::tie(b.changeset, b.slot);
+    });
+
+    // Index of the current part of each partition, which is the last part
+    // created for it.
+    std::vector<size_t> last_changeset(m_partitions.size(), size_t(-1));
+    for (const Slot& slot : slots) {
+        Partition& partition = m_partitions[m_groups[slot.group].partition];
+        auto& parts = ours ? partition.ours : partition.theirs;
+        size_t& last = last_changeset[m_groups[slot.group].partition];
+        Changeset& original = ours ? *m_our_changesets[slot.changeset] : m_their_changesets[slot.changeset];
+        if (last != slot.changeset) {
+            last = slot.changeset;
+            Part& part = parts.emplace_back();
+            part.original = &original;
+            part.changeset.share_strings(original);
+            part.changeset.version = original.version;
+            part.changeset.last_integrated_remote_version = original.last_integrated_remote_version;
+            part.changeset.origin_timestamp = original.origin_timestamp;
+            part.changeset.origin_file_ident = original.origin_file_ident;
+            part.changeset.transform_sequence = original.transform_sequence;
+            part.changeset.original_changeset_size = original.original_changeset_size;
+        }
+        Part& part = parts.back();
+        part.changeset.push_back(*(original.begin().m_inner + slot.slot));
+        part.slots.push_back(slot.slot);
+    }
+}
+
+void ParallelMerge::transform(Partition& partition)
+{
+    TransformerImpl transformer{false};
+    _impl::ChangesetIndex index;
+    for (Part& part : partition.theirs)
+        index.scan_changeset(part.changeset);
+    for (Part& part : partition.ours)
+        index.scan_changeset(part.changeset);
+    for (Part& part : partition.theirs)
+        index.add_changeset(part.changeset);
+
+    for (Part& part : partition.ours) {
+        transformer.m_major_side.set_next_changeset(&part.changeset);
+        transformer.m_minor_side.m_changeset_index = &index;
+        transformer.transform(); // Throws
+    }
+}
+
+void ParallelMerge::run(Logger& logger)
+{
+    logger.debug(util::LogCategory::changeset, "Transforming %1 conflict group(s) on %2 threads", m_groups.size(),
+                 m_partitions.size());
+
+    MergeWorkerPool::get().run(
+        m_partitions.size() - 1,
+        [&](size_t i) {
+            transform(m_partitions[i + 1]); // Throws
+        },
+        [&] {
+            transform(m_partitions[0]); // Throws
+        }); // Throws
+
+    for (auto& partition : m_partitions) {
+        for (auto* parts : {&partition.theirs, &partition.ours}) {
+            for (Part& part : *parts) {
+                // Instructions referring to strings interned during the
+                // sub-merge would be invalid in the original changeset.
+                REALM_ASSERT_RELEASE(part.changeset.shares_strings());
+                auto first_slot = part.original->begin().m_inner;
+                auto transformed_slot = part.changeset.begin().m_inner;
+                for (size_t slot : part.slots)
+                    *(first_slot + slot) = std::move(*transformed_slot++);
+                if (part.changeset.is_dirty())
+                    part.original->set_dirty(true);
+            }
+        }
+    }
+}
+
 } // anonymous namespace
 
 namespace realm::sync {
@@ -2477,17 +2816,24 @@ void Transformer::merge_changesets(file_ident_type local_file_ident, util::Span<
     static_cast<void>(local_file_ident);
 #endif // REALM_DEBUG LCOV_EXCL_STOP
 
-    for (size_t i = 0; i < our_changesets.size(); ++i) {
-        logger.trace(
-            util::LogCategory::changeset,
-            "Transforming local changeset [%1/%2] through %3 incoming changeset(s) with %4 conflict group(s)", i + 1,
-            our_changesets.size(), their_changesets.size(), their_index.get_num_conflict_groups());
-        Changeset* our_changeset = our_changesets[i];
-
-        transformer.m_major_side.set_next_changeset(our_changeset);
-        // MinorSide uses the index to find the Changeset.
-        transformer.m_minor_side.m_changeset_index = &their_index;
-        transformer.transform(); // Throws
+    ParallelMerge parallel_merge{their_index, their_changesets, our_changesets};
+    if (!trace && their_num_instructions + our_num_instructions >= m_config.min_parallel_instructions &&
+        parallel_merge.partition(m_config.max_threads)) {
+        parallel_merge.run(logger); // Throws
+    }
+    else {
+        for (size_t i = 0; i < our_changesets.size(); ++i) {
+            logger.trace(
+                util::LogCategory::changeset,
+                "Transforming local changeset [%1/%2] through %3 incoming changeset(s) with %4 conflict group(s)",
+                i + 1, our_changesets.size(), their_changesets.size(), their_index.get_num_conflict_groups());
+            Changeset* our_changeset = our_changesets[i];
+
+            transformer.m_major_side.set_next_changeset(our_changeset);
+            // MinorSide uses the index to find the Changeset.
+            transformer.m_minor_side.m_changeset_index = &their_index;
+            transformer.transform(); // Throws
+        }
     }
 
     logger.debug(util::LogCategory::changeset,
@@ -2598,7 +2944,8 @@ Changeset& Transformer::get_reciprocal_transform(TransformHistory& history, file
         ChunkedBinaryInputStream in{data};
         if (is_compressed) {
             size_t total_size;
-            auto decompressed = util::compression::decompress_nonportable_input_stream(in, total_size);
+            auto decompressed = util::compression::decompress_nonportable_input_stream(
+                in, total_size, history.get_compression_dictionary());
             REALM_ASSERT(decompressed);
             sync::parse_changeset(*decompressed, changeset); // Throws
         }
@@ -2634,20 +2981,25 @@ void Transformer::flush_reciprocal_transform_cache(TransformHistory& history)
 }
 
 void parse_remote_changeset(const RemoteChangeset& remote_changeset, Changeset& parsed_changeset)
+{
+    ChunkedBinaryInputStream remote_in{remote_changeset.data};
+    parse_changeset(remote_in, parsed_changeset); // Throws
+
+    copy_remote_changeset_metadata(remote_changeset, parsed_changeset);
+}
+
+void copy_remote_changeset_metadata(const RemoteChangeset& remote_changeset, Changeset& changeset)
 {
     // origin_file_ident = 0 is currently used to indicate an entry of local
     // origin.
     REALM_ASSERT(remote_changeset.origin_file_ident != 0);
     REALM_ASSERT(remote_changeset.remote_version != 0);
 
-    ChunkedBinaryInputStream remote_in{remote_changeset.data};
-    parse_changeset(remote_in, parsed_changeset); // Throws
-
-    parsed_changeset.version = remote_changeset.remote_version;
-    parsed_changeset.last_integrated_remote_version = remote_changeset.last_integrated_local_version;
-    parsed_changeset.origin_timestamp = remote_changeset.origin_timestamp;
-    parsed_changeset.origin_file_ident = remote_changeset.origin_file_ident;
-    parsed_changeset.original_changeset_size = remote_changeset.original_changeset_size;
+    changeset.version = remote_changeset.remote_version;
+    changeset.last_integrated_remote_version = remote_changeset.last_integrated_local_version;
+    changeset.origin_timestamp = remote_changeset.origin_timestamp;
+    changeset.origin_file_ident = remote_changeset.origin_file_ident;
+    changeset.original_changeset_size = remote_changeset.original_changeset_size;
 }
 
 } // namespace realm::sync
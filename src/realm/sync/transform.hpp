@@ -110,6 +110,13 @@ public:
     /// \param encoded_changeset The new reciprocally transformed changeset.
     virtual void set_reciprocal_transform(version_type version, BinaryData encoded_changeset) = 0;
 
+    /// Get the dictionary which compressed changesets returned by
+    /// get_reciprocal_transform() may have been compressed with.
+    virtual util::Span<const char> get_compression_dictionary() const noexcept
+    {
+        return {};
+    }
+
     virtual ~TransformHistory() noexcept {}
 };
 
@@ -126,6 +133,26 @@ public:
     using version_type = sync::version_type;
     using iterator = util::Span<Changeset>::iterator;
 
+    struct Config {
+        /// The maximum number of threads used to merge independent conflict
+        /// groups concurrently, including the calling thread. The default of
+        /// one disables concurrent merging. The worker threads are started
+        /// when first needed, and are shared by all transformers in the
+        /// process.
+        size_t max_threads = 1;
+
+        /// Merges involving fewer instructions than this, counting both
+        /// sides, are always carried out on the calling thread, as the cost of
+        /// handing work to other threads would outweigh the gain.
+        size_t min_parallel_instructions = 4096;
+    };
+
+    Transformer() = default;
+    explicit Transformer(Config config)
+        : m_config(config)
+    {
+    }
+
     /// Produce operationally transformed versions of the specified changesets,
     /// which are assumed to be received from a particular remote peer, P,
     /// represented by the specified transform history. Note that P is not
@@ -178,6 +205,7 @@ public:
                                        util::FunctionRef<bool(const Changeset*)> changeset_applier, util::Logger&);
 
 private:
+    Config m_config;
     std::map<version_type, Changeset> m_reciprocal_transform_cache;
 
     Changeset& get_reciprocal_transform(TransformHistory&, file_ident_type local_file_ident, version_type version,
@@ -238,6 +266,10 @@ public:
 
 void parse_remote_changeset(const RemoteChangeset&, Changeset&);
 
+/// Like parse_remote_changeset(), but only sets the metadata of the changeset
+/// (version, origin etc.) and leaves its instructions empty.
+void copy_remote_changeset_metadata(const RemoteChangeset&, Changeset&);
+
 
 // Implementation
 
@@ -345,6 +345,24 @@ void TableView::update_query(const Query& q)
     do_sync();
 }
 
+void TableView::set_query_result(const std::vector<ObjKey>& keys)
+{
+    util::CriticalSection cs(m_race_detector);
+    REALM_ASSERT(m_query);
+    REALM_ASSERT(m_descriptor_ordering.is_empty());
+    m_table.check();
+
+    if (m_key_values.is_attached())
+        m_key_values.clear();
+    else
+        m_key_values.create();
+    for (auto key : keys)
+        m_key_values.add(key);
+
+    m_last_seen_versions.clear();
+    get_dependencies(m_last_seen_versions);
+}
+
 void TableView::clear()
 {
     m_table.check();
@@ -259,6 +259,12 @@ public:
     // queries points to the same Table
     void update_query(const Query& q);
 
+    // Set the content of a TableView backed by a query to 'keys', which the
+    // caller knows to be the current result of the query in table order (e.g.
+    // because it updated a previous result from a change log), and mark the
+    // view as being in sync. Only valid for views without sort or distinct.
+    void set_query_result(const std::vector<ObjKey>& keys);
+
     std::unique_ptr<TableView> clone() const
     {
         return std::unique_ptr<TableView>(new TableView(*this));
@@ -229,6 +229,12 @@ std::unique_ptr<Tokenizer> Tokenizer::get_instance()
     return std::make_unique<DefaultTokenizer>();
 }
 
+Tokenizer& Tokenizer::get_thread_instance()
+{
+    thread_local DefaultTokenizer instance;
+    return instance;
+}
+
 } // namespace realm
 
 #ifdef TOKENIZER_UNITTEST
@@ -64,6 +64,8 @@ public:
     TokenInfoMap get_token_info();
 
     static std::unique_ptr<Tokenizer> get_instance();
+    // Returns a tokenizer owned by the calling thread, whose buffers are reused across calls
+    static Tokenizer& get_thread_instance();
 
 protected:
     std::string_view m_text;
@@ -247,11 +247,16 @@ std::string case_map(StringData source, bool upper, IgnoreErrorsTag)
 // spirit to std::equal().
 bool equal_case_fold(StringData haystack, const char* needle_upper, const char* needle_lower)
 {
+    unsigned char all_bytes = 0;
     for (size_t i = 0; i != haystack.size(); ++i) {
         char c = haystack[i];
         if (needle_lower[i] != c && needle_upper[i] != c)
             return false;
+        all_bytes |= static_cast<unsigned char>(c);
     }
+    // For pure ASCII the byte compare is exact
+    if ((all_bytes & 0x80) == 0)
+        return true;
 
     const char* begin = haystack.data();
     const char* end = begin + haystack.size();
@@ -269,15 +274,16 @@ bool equal_case_fold(StringData haystack, const char* needle_upper, const char*
 // in spirit to std::search().
 size_t search_case_fold(StringData haystack, const char* needle_upper, const char* needle_lower, size_t needle_size)
 {
-    // FIXME: This solution is very inefficient. Consider deploying the Boyer-Moore algorithm.
-    size_t i = 0;
-    while (needle_size <= haystack.size() - i) {
-        if (equal_case_fold(haystack.substr(i, needle_size), needle_upper, needle_lower)) {
-            return i;
-        }
-        ++i;
-    }
-    return haystack.size(); // Not found
+    if (needle_size == 0)
+        return 0;
+
+    // Candidates are found by matching the first and last byte in either case, so the
+    // full comparison is only done where both ends already agree
+    const char first[2] = {needle_upper[0], needle_lower[0]};
+    const char last[2] = {needle_upper[needle_size - 1], needle_lower[needle_size - 1]};
+    return _impl::search_first_last(haystack, needle_size, first, last, [&](size_t pos) {
+        return equal_case_fold(haystack.substr(pos, needle_size), needle_upper, needle_lower);
+    });
 }
 
 /// This method takes an array that maps chars (both upper- and lowercase) to distance that can be moved
@@ -294,6 +300,9 @@ bool contains_ins(StringData haystack, const char* needle_upper, const char* nee
     unsigned char lastCharU = needle_upper[last_char_pos];
     unsigned char lastCharL = needle_lower[last_char_pos];
 
+    if (needle_size <= _impl::s_first_last_max_needle_size && haystack.size() >= needle_size + 16)
+        return search_case_fold(haystack, needle_upper, needle_lower, needle_size) != haystack.size();
+
     // Do Boyer-Moore search
     size_t p = last_char_pos;
     while (p < haystack.size()) {
@@ -40,8 +40,15 @@ enum class Algorithm {
     None = 0,
     Deflate = 1,
     Lzfse = 2,
+    DeflateWithDictionary = 3,
 };
 
+// A preset dictionary only helps while the compressor can still reach back
+// into it, i.e. for the first 32 KB of input, so larger inputs are compressed
+// without one. With a dictionary even very small inputs compress well.
+constexpr size_t min_dictionary_input_size = 32;
+constexpr size_t max_dictionary_input_size = 32 * 1024;
+
 using stream_avail_size_t = std::conditional_t<sizeof(uInt) < sizeof(size_t), uInt, size_t>;
 constexpr stream_avail_size_t g_max_stream_avail = std::numeric_limits<stream_avail_size_t>::max();
 
@@ -180,18 +187,38 @@ size_t write_header(Header h, Span<char> target)
     return width + 1;
 }
 
-// Feed in a zlib header to inflate() for the places we don't store it
-void inflate_zlib_header(z_stream& strm)
+// Feed in a zlib header to inflate() for the places we don't store it. If the
+// data was compressed with a dictionary, the header has to announce one, and
+// the dictionary is then installed.
+void inflate_zlib_header(z_stream& strm, Span<const char> dictionary = {})
 {
     Bytef out;
-    strm.avail_in = 2;
-    strm.next_in = to_bytef("\x78\x5e");
     strm.avail_out = sizeof(out);
     strm.next_out = &out;
 
+    if (dictionary.empty()) {
+        strm.avail_in = 2;
+        strm.next_in = to_bytef("\x78\x5e");
+        int rc = inflate(&strm, Z_SYNC_FLUSH);
+        REALM_ASSERT(rc == Z_OK);
+        REALM_ASSERT(strm.avail_in == 0);
+        return;
+    }
+
+    REALM_ASSERT(dictionary.size() <= g_max_stream_avail);
+    auto dictionary_ptr = to_bytef(dictionary.data());
+    auto dictionary_size = uInt(dictionary.size());
+    uLong dictionary_id = adler32(1, dictionary_ptr, dictionary_size);
+    Bytef header[6] = {0x78, 0x7d}; // FDICT set, followed by the big-endian dictionary id
+    for (int i = 0; i < 4; ++i)
+        header[2 + i] = Bytef(dictionary_id >> (24 - 8 * i));
+    strm.avail_in = sizeof(header);
+    strm.next_in = header;
     int rc = inflate(&strm, Z_SYNC_FLUSH);
-    REALM_ASSERT(rc == Z_OK);
+    REALM_ASSERT(rc == Z_NEED_DICT);
     REALM_ASSERT(strm.avail_in == 0);
+    rc = inflateSetDictionary(&strm, dictionary_ptr, dictionary_size);
+    REALM_ASSERT(rc == Z_OK);
 }
 
 struct DecompressInputStreamNone final : public InputStream {
@@ -216,7 +243,8 @@ struct DecompressInputStreamNone final : public InputStream {
 
 class DecompressInputStreamZlib final : public InputStream {
 public:
-    DecompressInputStreamZlib(InputStream& s, Span<const char> b, size_t total_size)
+    DecompressInputStreamZlib(InputStream& s, Span<const char> b, size_t total_size,
+                              Span<const char> dictionary = {})
         : m_source(s)
     {
         // Arbitrary upper limit to reduce peak memory usage
@@ -226,7 +254,7 @@ public:
         int rc = inflateInit(&m_strm);
         if (rc != Z_OK)
             throw std::system_error(make_error_code(compression::error::decompress_error), m_strm.msg);
-        inflate_zlib_header(m_strm);
+        inflate_zlib_header(m_strm, dictionary);
 
         m_strm.avail_in = bounded_avail(b.size());
         m_strm.next_in = to_bytef(b.data());
@@ -397,7 +425,7 @@ std::error_code decompress_none(InputStream& compressed, Span<const char> compre
 }
 
 std::error_code decompress_zlib(InputStream& compressed, Span<const char> compressed_buf, Span<char> decompressed_buf,
-                                bool has_header)
+                                bool has_header, Span<const char> dictionary = {})
 {
     using namespace compression;
 
@@ -413,7 +441,7 @@ std::error_code decompress_zlib(InputStream& compressed, Span<const char> compre
     });
 
     if (!has_header)
-        inflate_zlib_header(strm);
+        inflate_zlib_header(strm, dictionary);
 
     do {
         size_t in_offset = 0;
@@ -581,7 +609,7 @@ API_AVAILABLE_END
 #endif
 
 std::error_code decompress(InputStream& compressed, Span<const char> compressed_buf, Span<char> decompressed_buf,
-                           Algorithm algorithm, bool has_header)
+                           Algorithm algorithm, bool has_header, Span<const char> dictionary = {})
 {
     using namespace compression;
 
@@ -593,7 +621,8 @@ std::error_code decompress(InputStream& compressed, Span<const char> compressed_
     }
 
 #if REALM_USE_LIBCOMPRESSION
-    if (algorithm != Algorithm::None)
+    // libcompression does not support preset dictionaries
+    if (algorithm != Algorithm::None && algorithm != Algorithm::DeflateWithDictionary)
         return decompress_libcompression(compressed, compressed_buf, decompressed_buf, algorithm, has_header);
 #endif
 
@@ -602,6 +631,10 @@ std::error_code decompress(InputStream& compressed, Span<const char> compressed_
             return decompress_none(compressed, compressed_buf, decompressed_buf);
         case Algorithm::Deflate:
             return decompress_zlib(compressed, compressed_buf, decompressed_buf, has_header);
+        case Algorithm::DeflateWithDictionary:
+            if (dictionary.empty())
+                return error::decompress_unsupported;
+            return decompress_zlib(compressed, compressed_buf, decompressed_buf, has_header, dictionary);
         default:
             return error::decompress_unsupported;
     }
@@ -636,6 +669,94 @@ void record_compression_result(size_t uncompressed, size_t compressed)
 void record_compression_result(size_t, size_t) {}
 #endif
 
+// zlib deflate(), optionally with a preset dictionary
+std::error_code compress_zlib(Span<const char> uncompressed_buf, Span<char> compressed_buf,
+                              std::size_t& compressed_size, int compression_level,
+                              compression::Alloc* custom_allocator, Span<const char> dictionary)
+{
+    using namespace compression;
+
+    auto uncompressed_ptr = to_bytef(uncompressed_buf.data());
+    auto uncompressed_size = uncompressed_buf.size();
+    auto compressed_ptr = to_bytef(compressed_buf.data());
+    auto compressed_buf_size = compressed_buf.size();
+
+    z_stream strm = {};
+    if (custom_allocator) {
+        strm.opaque = custom_allocator;
+        strm.zalloc = &custom_alloc;
+        strm.zfree = &custom_free;
+    }
+
+    int rc = deflateInit(&strm, compression_level);
+    if (rc == Z_MEM_ERROR)
+        return error::out_of_memory;
+
+    if (rc != Z_OK)
+        return error::compress_error;
+
+    if (dictionary.size()) {
+        REALM_ASSERT(dictionary.size() <= g_max_stream_avail);
+        rc = deflateSetDictionary(&strm, to_bytef(dictionary.data()), uInt(dictionary.size()));
+        if (rc != Z_OK) {
+            deflateEnd(&strm);
+            return error::compress_error;
+        }
+    }
+
+    strm.next_in = uncompressed_ptr;
+    strm.avail_in = 0;
+    strm.next_out = compressed_ptr;
+    strm.avail_out = 0;
+
+    std::size_t next_in_ndx = 0;
+    std::size_t next_out_ndx = 0;
+    REALM_ASSERT(rc == Z_OK);
+    while (rc == Z_OK || rc == Z_BUF_ERROR) {
+        REALM_ASSERT(strm.next_in + strm.avail_in == uncompressed_ptr + next_in_ndx);
+        REALM_ASSERT(strm.next_out + strm.avail_out == compressed_ptr + next_out_ndx);
+
+        bool stream_updated = false;
+
+        if (strm.avail_in == 0 && next_in_ndx < uncompressed_size) {
+            auto in_size = bounded_avail(uncompressed_size - next_in_ndx);
+            next_in_ndx += in_size;
+            strm.avail_in = uInt(in_size);
+            stream_updated = true;
+        }
+
+        if (strm.avail_out == 0 && next_out_ndx < compressed_buf_size) {
+            auto out_size = bounded_avail(compressed_buf_size - next_out_ndx);
+            next_out_ndx += out_size;
+            strm.avail_out = uInt(out_size);
+            stream_updated = true;
+        }
+
+        if (rc == Z_BUF_ERROR && !stream_updated) {
+            deflateEnd(&strm);
+            return error::compress_buffer_too_small;
+        }
+
+        int flush = (next_in_ndx == uncompressed_size) ? Z_FINISH : Z_NO_FLUSH;
+
+        rc = deflate(&strm, flush);
+        REALM_ASSERT(rc != Z_STREAM_END || flush == Z_FINISH);
+    }
+
+    if (rc != Z_STREAM_END) {
+        deflateEnd(&strm);
+        return error::compress_error;
+    }
+
+    compressed_size = next_out_ndx - strm.avail_out;
+
+    rc = deflateEnd(&strm);
+    if (rc != Z_OK)
+        return error::compress_error;
+
+    return std::error_code{};
+}
+
 #if REALM_USE_LIBCOMPRESSION
 API_AVAILABLE_BEGIN(macos(10.11))
 std::error_code compress_lzfse(Span<const char> uncompressed_buf, Span<char> compressed_buf,
@@ -694,8 +815,8 @@ std::error_code compress_lzfse_or_zlib(Span<const char> uncompressed_buf, Span<c
 #endif
     size_t len = header_width(uncompressed_buf.size());
     REALM_ASSERT(len >= 2);
-    auto ec = compress(uncompressed_buf, compressed_buf.sub_span(len - 2), compressed_size, compression_level,
-                       custom_allocator);
+    auto ec = compress_zlib(uncompressed_buf, compressed_buf.sub_span(len - 2), compressed_size, compression_level,
+                            custom_allocator, {});
     if (!ec) {
         // Note: overwrites zlib header
         write_header({Algorithm::Deflate, uncompressed_buf.size()}, compressed_buf);
@@ -703,6 +824,27 @@ std::error_code compress_lzfse_or_zlib(Span<const char> uncompressed_buf, Span<c
     }
     return ec;
 }
+
+std::error_code compress_with_dictionary(Span<const char> uncompressed_buf, Span<char> compressed_buf,
+                                         std::size_t& compressed_size, int compression_level,
+                                         Span<const char> dictionary, compression::Alloc* custom_allocator)
+{
+    // With a dictionary the zlib header is six bytes long (it includes the
+    // dictionary id), which may be more than our own header, so the zlib
+    // header is written after ours and then squeezed out. It is reconstructed
+    // from the dictionary by inflate_zlib_header().
+    constexpr size_t zlib_header_size = 6;
+    size_t len = write_header({Algorithm::DeflateWithDictionary, uncompressed_buf.size()}, compressed_buf);
+    auto target = compressed_buf.sub_span(len);
+    auto ec =
+        compress_zlib(uncompressed_buf, target, compressed_size, compression_level, custom_allocator, dictionary);
+    if (!ec) {
+        REALM_ASSERT(compressed_size > zlib_header_size);
+        compressed_size -= zlib_header_size;
+        std::memmove(target.data(), target.data() + zlib_header_size, compressed_size);
+    }
+    return ec;
+}
 } // unnamed namespace
 
 
@@ -735,76 +877,7 @@ std::size_t compression::compress_bound(std::size_t size) noexcept
 std::error_code compression::compress(Span<const char> uncompressed_buf, Span<char> compressed_buf,
                                       std::size_t& compressed_size, int compression_level, Alloc* custom_allocator)
 {
-    auto uncompressed_ptr = to_bytef(uncompressed_buf.data());
-    auto uncompressed_size = uncompressed_buf.size();
-    auto compressed_ptr = to_bytef(compressed_buf.data());
-    auto compressed_buf_size = compressed_buf.size();
-
-    z_stream strm = {};
-    if (custom_allocator) {
-        strm.opaque = custom_allocator;
-        strm.zalloc = &custom_alloc;
-        strm.zfree = &custom_free;
-    }
-
-    int rc = deflateInit(&strm, compression_level);
-    if (rc == Z_MEM_ERROR)
-        return error::out_of_memory;
-
-    if (rc != Z_OK)
-        return error::compress_error;
-
-    strm.next_in = uncompressed_ptr;
-    strm.avail_in = 0;
-    strm.next_out = compressed_ptr;
-    strm.avail_out = 0;
-
-    std::size_t next_in_ndx = 0;
-    std::size_t next_out_ndx = 0;
-    REALM_ASSERT(rc == Z_OK);
-    while (rc == Z_OK || rc == Z_BUF_ERROR) {
-        REALM_ASSERT(strm.next_in + strm.avail_in == uncompressed_ptr + next_in_ndx);
-        REALM_ASSERT(strm.next_out + strm.avail_out == compressed_ptr + next_out_ndx);
-
-        bool stream_updated = false;
-
-        if (strm.avail_in == 0 && next_in_ndx < uncompressed_size) {
-            auto in_size = bounded_avail(uncompressed_size - next_in_ndx);
-            next_in_ndx += in_size;
-            strm.avail_in = uInt(in_size);
-            stream_updated = true;
-        }
-
-        if (strm.avail_out == 0 && next_out_ndx < compressed_buf_size) {
-            auto out_size = bounded_avail(compressed_buf_size - next_out_ndx);
-            next_out_ndx += out_size;
-            strm.avail_out = uInt(out_size);
-            stream_updated = true;
-        }
-
-        if (rc == Z_BUF_ERROR && !stream_updated) {
-            deflateEnd(&strm);
-            return error::compress_buffer_too_small;
-        }
-
-        int flush = (next_in_ndx == uncompressed_size) ? Z_FINISH : Z_NO_FLUSH;
-
-        rc = deflate(&strm, flush);
-        REALM_ASSERT(rc != Z_STREAM_END || flush == Z_FINISH);
-    }
-
-    if (rc != Z_STREAM_END) {
-        deflateEnd(&strm);
-        return error::compress_error;
-    }
-
-    compressed_size = next_out_ndx - strm.avail_out;
-
-    rc = deflateEnd(&strm);
-    if (rc != Z_OK)
-        return error::compress_error;
-
-    return std::error_code{};
+    return compress_zlib(uncompressed_buf, compressed_buf, compressed_size, compression_level, custom_allocator, {});
 }
 
 std::error_code compression::decompress(InputStream& compressed, Span<char> decompressed_buf)
@@ -818,7 +891,8 @@ std::error_code compression::decompress(Span<const char> compressed_buf, Span<ch
     return ::decompress(adapter, adapter.next_block(), decompressed_buf, Algorithm::Deflate, true);
 }
 
-std::error_code compression::decompress_nonportable(InputStream& compressed, AppendBuffer<char>& decompressed)
+std::error_code compression::decompress_nonportable(InputStream& compressed, AppendBuffer<char>& decompressed,
+                                                    Span<const char> dictionary)
 {
     auto compressed_buf = compressed.next_block();
     auto header = read_header(compressed, compressed_buf);
@@ -827,7 +901,7 @@ std::error_code compression::decompress_nonportable(InputStream& compressed, App
     decompressed.resize(header.size);
     if (header.size == 0)
         return std::error_code{};
-    return ::decompress(compressed, compressed_buf, decompressed, header.algorithm, false);
+    return ::decompress(compressed, compressed_buf, decompressed, header.algorithm, false, dictionary);
 }
 
 std::error_code compression::allocate_and_compress(CompressMemoryArena& compress_memory_arena,
@@ -867,7 +941,7 @@ std::error_code compression::allocate_and_compress(CompressMemoryArena& compress
 }
 
 void compression::allocate_and_compress_nonportable(CompressMemoryArena& arena, Span<const char> uncompressed,
-                                                    util::AppendBuffer<char>& compressed)
+                                                    util::AppendBuffer<char>& compressed, Span<const char> dictionary)
 {
     if (uncompressed.size() == 0) {
         compressed.resize(0);
@@ -880,10 +954,15 @@ void compression::allocate_and_compress_nonportable(CompressMemoryArena& arena,
     // zlib is ineffective for very small sizes. Measured results indicate that
     // it only manages to compress at all past 100 bytes and the compression
     // ratio becomes interesting around 200 bytes.
-    while (uncompressed.size() > 256) {
+    bool use_dictionary = dictionary.size() && uncompressed.size() <= max_dictionary_input_size;
+    size_t min_compressed_input_size = use_dictionary ? min_dictionary_input_size : 256;
+    while (uncompressed.size() > min_compressed_input_size) {
         init_arena(arena);
         const int compression_level = 1;
-        auto ec = compress_lzfse_or_zlib(uncompressed, compressed, compressed_size, compression_level, &arena);
+        auto ec = use_dictionary
+                      ? compress_with_dictionary(uncompressed, compressed, compressed_size, compression_level,
+                                                 dictionary, &arena)
+                      : compress_lzfse_or_zlib(uncompressed, compressed, compressed_size, compression_level, &arena);
         if (ec == error::compress_buffer_too_small) {
             // Compressed result was larger than uncompressed, so just store the
             // uncompressed
@@ -913,15 +992,17 @@ void compression::allocate_and_compress_nonportable(CompressMemoryArena& arena,
     }
 }
 
-util::AppendBuffer<char> compression::allocate_and_compress_nonportable(Span<const char> uncompressed_buf)
+util::AppendBuffer<char> compression::allocate_and_compress_nonportable(Span<const char> uncompressed_buf,
+                                                                       Span<const char> dictionary)
 {
     util::compression::CompressMemoryArena arena;
     util::AppendBuffer<char> compressed;
-    allocate_and_compress_nonportable(arena, uncompressed_buf, compressed);
+    allocate_and_compress_nonportable(arena, uncompressed_buf, compressed, dictionary);
     return compressed;
 }
 
-std::unique_ptr<InputStream> compression::decompress_nonportable_input_stream(InputStream& source, size_t& total_size)
+std::unique_ptr<InputStream> compression::decompress_nonportable_input_stream(InputStream& source, size_t& total_size,
+                                                                              Span<const char> dictionary)
 {
     auto first_block = source.next_block();
     auto header = read_header(source, first_block);
@@ -931,6 +1012,11 @@ std::unique_ptr<InputStream> compression::decompress_nonportable_input_stream(In
 
     if (header.algorithm == Algorithm::None)
         return std::make_unique<DecompressInputStreamNone>(source, first_block);
+    if (header.algorithm == Algorithm::DeflateWithDictionary) {
+        if (dictionary.empty())
+            return nullptr;
+        return std::make_unique<DecompressInputStreamZlib>(source, first_block, total_size, dictionary);
+    }
 #if REALM_USE_LIBCOMPRESSION
     if (header.algorithm == Algorithm::Deflate || header.algorithm == Algorithm::Lzfse)
         return std::make_unique<DecompressInputStreamLibCompression>(source, first_block, header);
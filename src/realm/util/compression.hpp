@@ -163,7 +163,11 @@ std::error_code allocate_and_compress(CompressMemoryArena& compress_memory_arena
 /// \a decompressed is resized to the required size, and on non-error return
 /// has size equal to the compressed size. All errors other than std::bad_alloc
 /// are returned as an error code of categrory compression::error_code.
-std::error_code decompress_nonportable(InputStream& compressed, AppendBuffer<char>& decompressed);
+///
+/// If the data was compressed with a dictionary, the same \a dictionary must
+/// be passed here. If it is not, error::decompress_unsupported is returned.
+std::error_code decompress_nonportable(InputStream& compressed, AppendBuffer<char>& decompressed,
+                                       Span<const char> dictionary = {});
 
 /// decompress_nonportable_input_stream() returns an input stream which wraps
 /// the \a source input stream and decompresses data produced by
@@ -172,8 +176,11 @@ std::error_code decompress_nonportable(InputStream& compressed, AppendBuffer<cha
 /// errors will be reported by throwing a std::system_error containing an error
 /// code of category compression::error_code. If this returns a non-nullptr
 /// input stream, \a total_size is set to the decompressed size of the data
-/// which will be produced by fully consuming the returned input stream.
-std::unique_ptr<InputStream> decompress_nonportable_input_stream(InputStream& source, size_t& total_size);
+/// which will be produced by fully consuming the returned input stream. Data
+/// which was compressed with a dictionary is unsupported unless the same \a
+/// dictionary is passed.
+std::unique_ptr<InputStream> decompress_nonportable_input_stream(InputStream& source, size_t& total_size,
+                                                                 Span<const char> dictionary = {});
 
 /// allocate_and_compress_nonportable() compresses the data stored in \a
 /// uncompressed_buf, writing it to \a compressed_buf.
@@ -184,11 +191,17 @@ std::unique_ptr<InputStream> decompress_nonportable_input_stream(InputStream& so
 /// of compression algorithms available is platform-specific, so data
 /// compressed with this function must only be used locally.
 ///
+/// If \a dictionary is non-empty, it is used as a preset dictionary for data
+/// which is small enough to benefit from one. This lets very small inputs,
+/// which otherwise would be stored uncompressed, refer back to byte sequences
+/// that are common in the data being stored. The same dictionary must be
+/// supplied when decompressing.
+///
 /// This function reports errors by throwing a std::system_error containing an
 /// error code of category compression::error_code. It may additionally throw
 /// std::bad_alloc.
 void allocate_and_compress_nonportable(CompressMemoryArena& compress_memory_arena, Span<const char> uncompressed_buf,
-                                       util::AppendBuffer<char>& compressed_buf);
+                                       util::AppendBuffer<char>& compressed_buf, Span<const char> dictionary = {});
 
 /// allocate_and_compress_nonportable() compresses the data stored in \a
 /// uncompressed_buf, returning a buffer of the appropriate size.
@@ -202,7 +215,8 @@ void allocate_and_compress_nonportable(CompressMemoryArena& compress_memory_aren
 /// This function reports errors by throwing a std::system_error containing an
 /// error code of category compression::error_code. It may additionally throw
 /// std::bad_alloc.
-util::AppendBuffer<char> allocate_and_compress_nonportable(Span<const char> uncompressed_buf);
+util::AppendBuffer<char> allocate_and_compress_nonportable(Span<const char> uncompressed_buf,
+                                                           Span<const char> dictionary = {});
 
 /// Get the decompressed size of the data produced by
 /// allocate_and_compress_nonportable() which is stored in \a source.
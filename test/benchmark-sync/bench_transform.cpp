@@ -5,6 +5,11 @@
 #include "../test_all.hpp"
 #include "../sync_fixtures.hpp"
 
+#include <realm/sync/changeset_parser.hpp>
+#include <realm/sync/instruction_applier.hpp>
+#include <realm/sync/noinst/client_history_impl.hpp>
+#include <realm/util/compression.hpp>
+
 using namespace realm;
 using namespace realm::test_util::unit_test;
 using namespace realm::fixtures;
@@ -261,6 +266,212 @@ void connected_objects(TestContext& test_context)
     results->finish(ident, ident, "runtime_secs");
 }
 
+// One peer creates `num_objects` objects with 18 properties each in a
+// single transaction. The changeset is applied to an empty Realm, as when a
+// client integrates a large download.
+template <size_t num_objects>
+void apply_instructions(TestContext& test_context)
+{
+    std::string ident = test_context.test_details.test_name;
+
+    sync::Changeset changeset;
+    {
+        TEST_CLIENT_DB(db);
+        WriteTransaction wt(db);
+        TableRef t = wt.get_group().add_table_with_primary_key("class_t", type_Int, "pk");
+        std::vector<ColKey> int_cols;
+        std::vector<ColKey> string_cols;
+        for (int k = 0; k < 8; ++k) {
+            int_cols.push_back(t->add_column(type_Int, util::format("int_%1", k)));
+            string_cols.push_back(t->add_column(type_String, util::format("string_%1", k)));
+        }
+        ColKey col_double = t->add_column(type_Double, "double");
+        ColKey col_link = t->add_column(*t, "link");
+        for (size_t j = 0; j < num_objects; ++j) {
+            Obj obj = t->create_object_with_primary_key(int64_t(j));
+            for (ColKey col : int_cols)
+                obj.set(col, int64_t(j));
+            for (ColKey col : string_cols)
+                obj.set(col, std::string(20, char('a' + j % 26)));
+            obj.set(col_double, double(j) / 2);
+            obj.set(col_link, t->get_objkey_from_primary_key(int64_t(j / 2)));
+        }
+        wt.commit();
+
+        auto& repl = static_cast<sync::ClientReplication&>(*db->get_replication());
+        const auto& buffer = repl.get_instruction_encoder().buffer();
+        util::SimpleInputStream stream{buffer};
+        sync::parse_changeset(stream, changeset);
+    }
+
+    for (size_t i = 0; i < 3; ++i) {
+        TEST_CLIENT_DB(db);
+        auto& repl = static_cast<sync::ClientReplication&>(*db->get_replication());
+        WriteTransaction wt(db);
+        Timer t{Timer::type_RealTime};
+        {
+            sync::TempShortCircuitReplication tscr{repl};
+            sync::InstructionApplier applier{wt};
+            applier.apply(changeset);
+        }
+        results->submit(ident.c_str(), t.get_elapsed_time());
+        CHECK_EQUAL(wt.get_table("class_t")->size(), num_objects);
+    }
+
+    results->finish(ident, ident, "runtime_secs");
+}
+
+void add_task_table(DBRef& db)
+{
+    WriteTransaction wt(db);
+    TableRef t = wt.get_group().add_table_with_primary_key("class_Task", type_ObjectId, "_id");
+    t->add_column(type_String, "title");
+    t->add_column(type_Bool, "done");
+    t->add_column(type_Int, "priority");
+    t->add_column(type_Timestamp, "updated");
+    wt.commit();
+}
+
+// The `i`th of a series of small transactions, such as an app would make while
+// offline. Every third transaction creates a task and the others update one.
+void commit_task_transaction(DBRef& db, std::vector<ObjectId>& ids, size_t i)
+{
+    WriteTransaction wt(db);
+    TableRef t = wt.get_table("class_Task");
+    if (ids.empty() || i % 3 == 0) {
+        ids.push_back(ObjectId::gen());
+        Obj obj = t->create_object_with_primary_key(ids.back());
+        obj.set("title", util::format("Task number %1", i));
+        obj.set("priority", int64_t(i % 5));
+    }
+    else {
+        Obj obj = t->get_object_with_primary_key(ids[i % ids.size()]);
+        obj.set("done", i % 2 == 0);
+    }
+    t->get_object_with_primary_key(ids.back()).set("updated", Timestamp(1700000000 + i, 0));
+    wt.commit();
+}
+
+// A client makes `num_transactions` small transactions, and the resulting
+// changesets are compressed as they are stored in the client history. With a
+// dictionary, they are compressed against the first 4 KB of changesets, as
+// done by ClientHistory.
+template <size_t num_transactions, bool with_dictionary>
+void compress_history(TestContext& test_context)
+{
+    std::string ident = test_context.test_details.test_name;
+
+    std::vector<std::string> changesets;
+    {
+        TEST_CLIENT_DB(db);
+        auto& repl = static_cast<sync::ClientReplication&>(*db->get_replication());
+        add_task_table(db);
+        std::vector<ObjectId> ids;
+        for (size_t i = 0; i < num_transactions; ++i) {
+            commit_task_transaction(db, ids, i);
+            const auto& buffer = repl.get_instruction_encoder().buffer();
+            changesets.emplace_back(buffer.data(), buffer.size());
+        }
+    }
+
+    std::string dictionary;
+    if (with_dictionary) {
+        for (size_t i = 0; i < changesets.size() && dictionary.size() < 4 * 1024; ++i)
+            dictionary += changesets[i];
+    }
+
+    size_t uncompressed_size = 0;
+    size_t compressed_size = 0;
+    for (size_t i = 0; i < 5; ++i) {
+        uncompressed_size = 0;
+        compressed_size = 0;
+        util::compression::CompressMemoryArena arena;
+        util::AppendBuffer<char> compressed;
+        Timer t{Timer::type_RealTime};
+        for (const std::string& changeset : changesets) {
+            util::compression::allocate_and_compress_nonportable(arena, changeset, compressed, dictionary);
+            uncompressed_size += changeset.size();
+            compressed_size += compressed.size();
+        }
+        results->submit(ident.c_str(), t.get_elapsed_time());
+    }
+    test_context.logger->info("%1: %2 bytes compressed to %3 bytes", ident, uncompressed_size, compressed_size);
+
+    results->finish(ident, ident, "runtime_secs");
+}
+
+// The same small transactions are committed to a client history, measuring
+// the whole write transaction including storing the compressed changeset.
+template <size_t num_transactions>
+void commit_to_history(TestContext& test_context)
+{
+    std::string ident = test_context.test_details.test_name;
+
+    for (size_t i = 0; i < 5; ++i) {
+        TEST_CLIENT_DB(db);
+        add_task_table(db);
+        std::vector<ObjectId> ids;
+        Timer t{Timer::type_RealTime};
+        for (size_t j = 0; j < num_transactions; ++j)
+            commit_task_transaction(db, ids, j);
+        results->submit(ident.c_str(), t.get_elapsed_time());
+    }
+
+    results->finish(ident, ident, "runtime_secs");
+}
+
+// `num_files` clients each upload 100 transactions to their own Realm file on
+// a server with `num_workers` worker threads. The time is measured from when
+// the clients connect and until the server has integrated all the changes.
+template <int num_files, int num_workers>
+void integrate_on_server(TestContext& test_context)
+{
+    std::string ident = test_context.test_details.test_name;
+
+    for (size_t i = 0; i < 3; ++i) {
+        std::vector<test_util::DBTestPathGuard> path_guards;
+        std::vector<DBRef> dbs;
+        for (int j = 0; j < num_files; ++j) {
+            std::string path = test_util::get_test_path(test_context.get_test_name(), util::format("%1.%2", i, j));
+            path_guards.emplace_back(path);
+            DBRef db = DB::create(make_client_replication(), path);
+            for (int k = 0; k < 100; ++k) {
+                WriteTransaction wt(db);
+                TableRef t = wt.get_group().get_table("class_t");
+                if (!t) {
+                    t = wt.get_group().add_table_with_primary_key("class_t", type_Int, "pk");
+                    t->add_column(type_Int, "value");
+                    t->add_column(type_String, "name");
+                }
+                for (int l = 0; l < 20; ++l) {
+                    Obj obj = t->create_object_with_primary_key(int64_t(k * 20 + l));
+                    obj.set("value", int64_t(l));
+                    obj.set("name", "abcdefghijklmnopqrstuvwxyz");
+                }
+                wt.commit();
+            }
+            dbs.push_back(std::move(db));
+        }
+
+        TEST_DIR(dir);
+        ClientServerFixture::Config config;
+        config.server_num_workers = num_workers;
+        config.server_public_key_path = "";
+        ClientServerFixture fixture(dir, test_context, std::move(config));
+        fixture.start();
+
+        Timer t{Timer::type_RealTime};
+        std::vector<sync::Session> sessions;
+        for (int j = 0; j < num_files; ++j)
+            sessions.push_back(fixture.make_bound_session(dbs[j], util::format("/file_%1", j)));
+        for (auto& session : sessions)
+            session.wait_for_upload_complete_or_client_stopped();
+        results->submit(ident.c_str(), t.get_elapsed_time());
+    }
+
+    results->finish(ident, ident, "runtime_secs");
+}
+
 } // namespace bench
 
 const int max_lead_text_width = 40;
@@ -330,6 +541,41 @@ TEST(BenchMergeManyConnectedObjects)
     bench::connected_objects<1000>(test_context);
 }
 
+TEST(BenchApply10000Objects)
+{
+    bench::apply_instructions<10000>(test_context);
+}
+
+TEST(BenchApply100000Objects)
+{
+    bench::apply_instructions<100000>(test_context);
+}
+
+TEST(BenchCompressHistory)
+{
+    bench::compress_history<5000, false>(test_context);
+}
+
+TEST(BenchCompressHistoryWithDictionary)
+{
+    bench::compress_history<5000, true>(test_context);
+}
+
+TEST(BenchCommitToHistory)
+{
+    bench::commit_to_history<5000>(test_context);
+}
+
+TEST(BenchServerIntegrate16Files1Worker)
+{
+    bench::integrate_on_server<16, 1>(test_context);
+}
+
+TEST(BenchServerIntegrate16Files4Workers)
+{
+    bench::integrate_on_server<16, 4>(test_context);
+}
+
 #if !REALM_IOS
 int main()
 {
@@ -29,6 +29,7 @@
 #include <realm/object-store/results.hpp>
 #include <realm/object-store/schema.hpp>
 #include <realm/object-store/sectioned_results.hpp>
+#include <realm/object-store/impl/collection_change_builder.hpp>
 #include <realm/object-store/impl/realm_coordinator.hpp>
 
 using namespace realm;
@@ -335,6 +336,52 @@ TEST_CASE("Benchmark results notifier", "[benchmark][results]") {
     }
 }
 
+TEST_CASE("Benchmark collection change calculation", "[benchmark][results]") {
+    static const int64_t object_count = 100'000;
+    ObjKeys objs;
+    for (int64_t i = 0; i < object_count; ++i)
+        objs.push_back(ObjKey(i));
+    auto none_modified = [](ObjKey) {
+        return false;
+    };
+
+    ObjKeys appended = objs;
+    for (int64_t i = 0; i < 10; ++i)
+        appended.push_back(ObjKey(object_count + i));
+    BENCHMARK("append") {
+        return _impl::CollectionChangeBuilder::calculate(objs, appended, none_modified, true);
+    };
+
+    ObjKeys removed;
+    for (int64_t i = 0; i < object_count; ++i) {
+        if (i % 100 != 50)
+            removed.push_back(ObjKey(i));
+    }
+    BENCHMARK("table order with removals") {
+        return _impl::CollectionChangeBuilder::calculate(objs, removed, none_modified, true);
+    };
+
+    ObjKeys moved_near_end = objs;
+    std::swap(moved_near_end[object_count - 10], moved_near_end[object_count - 5]);
+    BENCHMARK("sorted with a move near the end") {
+        return _impl::CollectionChangeBuilder::calculate(objs, moved_near_end, none_modified, false);
+    };
+
+    ObjKeys few_moves = objs;
+    for (int64_t i = 0; i < 10; ++i)
+        std::swap(few_moves[i * 10'000 + 1], few_moves[i * 10'000 + 5'000]);
+    BENCHMARK("sorted with a few moves") {
+        return _impl::CollectionChangeBuilder::calculate(objs, few_moves, none_modified, false);
+    };
+
+    ObjKeys many_moves = objs;
+    for (size_t i = 0; i + 1 < many_moves.size(); i += 2)
+        std::swap(many_moves[i], many_moves[i + 1]);
+    BENCHMARK("sorted with many moves") {
+        return _impl::CollectionChangeBuilder::calculate(objs, many_moves, none_modified, false);
+    };
+}
+
 TEST_CASE("aggregates", "[benchmark][aggregate]") {
     InMemoryTestFile config;
     config.schema = Schema{
@@ -22,7 +22,9 @@
 
 #include "util/index_helpers.hpp"
 
+#include <algorithm>
 #include <limits>
+#include <numeric>
 
 using namespace realm;
 
@@ -673,6 +675,47 @@ TEST_CASE("collection_change: calculate() sorted", "[collection change]") {
             }
         }
     }
+
+    SECTION("diffs only the rows between unchanged leading and trailing rows") {
+        std::vector<size_t> old_rows(1000), new_rows;
+        std::iota(old_rows.begin(), old_rows.end(), 0);
+
+        new_rows = old_rows;
+        new_rows.push_back(2000);
+        new_rows.push_back(2001);
+        c = _impl::CollectionChangeBuilder::calculate(old_rows, new_rows, none_modified);
+        REQUIRE_INDICES(c.insertions, 1000, 1001);
+        REQUIRE(c.deletions.empty());
+
+        new_rows = old_rows;
+        std::swap(new_rows[997], new_rows[998]);
+        c = _impl::CollectionChangeBuilder::calculate(old_rows, new_rows, [](size_t ndx) {
+            return ndx == 5 || ndx == 999;
+        });
+        REQUIRE_INDICES(c.insertions, 997);
+        REQUIRE_INDICES(c.deletions, 998);
+        REQUIRE_INDICES(c.modifications, 5, 999);
+    }
+
+    SECTION("reports moved rows as removed and reinserted when there are too many moves") {
+        std::vector<size_t> old_rows(10000);
+        std::iota(old_rows.begin(), old_rows.end(), 0);
+        // Swapping each pair of rows after the first one makes every other row a move
+        auto new_rows = old_rows;
+        for (size_t i = 1; i + 1 < new_rows.size(); i += 2)
+            std::swap(new_rows[i], new_rows[i + 1]);
+        c = _impl::CollectionChangeBuilder::calculate(old_rows, new_rows, none_modified);
+        REQUIRE(c.deletions.count() == 9998);
+        REQUIRE(c.insertions.count() == 9998);
+        REQUIRE_FALSE(c.deletions.contains(0));
+
+        // A few moves are still reported exactly
+        new_rows = old_rows;
+        std::rotate(new_rows.begin() + 10, new_rows.begin() + 11, new_rows.begin() + 5000);
+        c = _impl::CollectionChangeBuilder::calculate(old_rows, new_rows, none_modified);
+        REQUIRE_INDICES(c.deletions, 10);
+        REQUIRE_INDICES(c.insertions, 4999);
+    }
 }
 
 TEST_CASE("collection_change: merge()", "[collection change]") {
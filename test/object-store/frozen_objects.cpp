@@ -110,6 +110,22 @@ TEST_CASE("Freeze Realm", "[frozen]") {
         realm->close();
         REQUIRE(DB::call_with_lock(config.path, [](auto) {}));
     }
+
+    SECTION("frozen Realms at the same version share a transaction") {
+        Realm::Config uncached_config = config;
+        uncached_config.cache = false;
+        auto frozen_realm_2 = Realm::get_frozen_realm(uncached_config, realm->read_transaction_version());
+        REQUIRE(frozen_realm_2 != frozen_realm);
+        REQUIRE(&frozen_realm_2->read_group() == &frozen_realm->read_group());
+
+        // Closing one of them leaves the transaction usable by the other
+        frozen_realm->close();
+        REQUIRE(frozen_realm_2->read_group().get_table("class_object"));
+
+        frozen_realm_2->close();
+        realm->close();
+        REQUIRE(DB::call_with_lock(config.path, [](auto) {}));
+    }
 }
 
 TEST_CASE("Freeze Results", "[frozen]") {
@@ -319,6 +335,29 @@ TEST_CASE("Freeze Results", "[frozen]") {
         });
     }
 
+    SECTION("Result constructor - frozen TableView") {
+        Realm::Config uncached_config = config;
+        uncached_config.cache = false;
+        auto frozen_realm_2 = Realm::get_frozen_realm(uncached_config, realm->read_transaction_version());
+        auto frozen_table = frozen_realm->read_group().get_table("class_object");
+        DescriptorOrdering ordering;
+        ordering.append_sort(SortDescriptor({{value_col}}, {false}));
+        Results results(frozen_realm, frozen_table->column<Int>(value_col) > 2, ordering);
+        REQUIRE(results.get(0).get<Int>(value_col) == 9);
+        REQUIRE(results.get_mode() == Results::Mode::TableView);
+
+        // The evaluated results are shared rather than imported and run again
+        Results frozen_res = results.freeze(frozen_realm_2);
+        REQUIRE(frozen_res.get_realm() == frozen_realm_2);
+        REQUIRE(frozen_res.get_mode() == Results::Mode::TableView);
+        JoiningThread thread([&] {
+            REQUIRE(frozen_res.is_frozen());
+            REQUIRE(frozen_res.size() == 7);
+            REQUIRE(frozen_res.get(0).get<Int>(value_col) == 9);
+            REQUIRE(frozen_res.get(6).get<Int>(value_col) == 3);
+        });
+    }
+
     SECTION("Result constructor - LinkList") {
         Results results(realm, table);
         Obj obj = results.get(0);
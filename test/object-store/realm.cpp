@@ -3842,6 +3842,77 @@ TEST_CASE("SharedRealm: coordinator schema cache") {
     }
 }
 
+TEST_CASE("RealmCoordinator: schema cache is retained after closing the Realm") {
+    TestFile config;
+    config.schema_version = 1;
+    config.schema = Schema{
+        {"object",
+         {{"value", PropertyType::Int}, {"link", PropertyType::Object | PropertyType::Nullable, "object"}}},
+    };
+    Realm::get_shared_realm(config)->close();
+    REQUIRE_FALSE(_impl::RealmCoordinator::get_existing_coordinator(config.path));
+
+    Schema cache_schema;
+    uint64_t cache_sv = -1, cache_tv = -1;
+
+    auto external_write = [&](auto&& fn) {
+        auto db = DB::create(make_in_realm_history(), config.path);
+        auto tr = db->start_write();
+        fn(*tr);
+        tr->commit();
+    };
+
+    SECTION("is reused when the file is unchanged") {
+        auto coordinator = _impl::RealmCoordinator::get_coordinator(config);
+        REQUIRE(coordinator->get_cached_schema(cache_schema, cache_sv, cache_tv));
+        REQUIRE(cache_sv == 1);
+        REQUIRE(cache_schema == ObjectStore::schema_from_group(*coordinator->begin_read()));
+        REQUIRE(cache_schema.find("object")->persisted_properties[0].column_key != ColKey{});
+    }
+
+    SECTION("is reused after a write which did not change the schema") {
+        external_write([](Transaction& tr) {
+            tr.get_table("class_object")->create_object();
+        });
+        auto coordinator = _impl::RealmCoordinator::get_coordinator(config);
+        REQUIRE(coordinator->get_cached_schema(cache_schema, cache_sv, cache_tv));
+        REQUIRE(cache_tv == coordinator->begin_read()->get_version_of_current_transaction().version);
+    }
+
+    SECTION("is discarded after a schema change") {
+        external_write([](Transaction& tr) {
+            tr.get_table("class_object")->add_column(type_String, "name", true);
+        });
+        auto coordinator = _impl::RealmCoordinator::get_coordinator(config);
+        REQUIRE_FALSE(coordinator->get_cached_schema(cache_schema, cache_sv, cache_tv));
+
+        config.schema = util::none;
+        auto realm = Realm::get_shared_realm(config);
+        REQUIRE(realm->schema().find("object")->property_for_name("name"));
+    }
+
+    SECTION("is discarded after a search index is added") {
+        external_write([](Transaction& tr) {
+            auto table = tr.get_table("class_object");
+            table->add_search_index(table->get_column_key("value"));
+        });
+        auto coordinator = _impl::RealmCoordinator::get_coordinator(config);
+        REQUIRE_FALSE(coordinator->get_cached_schema(cache_schema, cache_sv, cache_tv));
+    }
+
+    SECTION("is discarded if the file was replaced") {
+        Realm::delete_files(config.path);
+        external_write([](Transaction& tr) {
+            auto table = tr.add_table("class_object");
+            table->add_column(type_Int, "other");
+            table->add_column(*table, "link");
+            ObjectStore::set_schema_version(tr, 1);
+        });
+        auto coordinator = _impl::RealmCoordinator::get_coordinator(config);
+        REQUIRE_FALSE(coordinator->get_cached_schema(cache_schema, cache_sv, cache_tv));
+    }
+}
+
 TEST_CASE("SharedRealm: dynamic schema mode doesn't invalidate object schema pointers when schema hasn't changed") {
     TestFile config;
 
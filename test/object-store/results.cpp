@@ -1263,6 +1263,116 @@ TEST_CASE("notifications: skip", "[notifications]") {
     }
 }
 
+TEST_CASE("notifications: parallel notifier execution", "[notifications]") {
+    _impl::RealmCoordinator::assert_no_open_realms();
+    InMemoryTestFile config;
+    config.automatic_change_notifications = false;
+    config.max_notifier_threads = 3;
+
+    auto r = Realm::get_shared_realm(config);
+    r->update_schema({
+        {"object", {{"value", PropertyType::Int}}},
+    });
+
+    auto coordinator = _impl::RealmCoordinator::get_coordinator(config.path);
+    auto table = r->read_group().get_table("class_object");
+    auto col = table->get_column_key("value");
+
+    r->begin_transaction();
+    for (int i = 0; i < 10; ++i)
+        table->create_object().set(col, i);
+    r->commit_transaction();
+
+    // More notifiers than threads, so some of them share a transaction
+    const int count = 7;
+    std::vector<Results> results;
+    results.reserve(count);
+    std::vector<NotificationToken> tokens;
+    std::vector<int> calls(count, 0);
+    std::vector<CollectionChangeSet> changes(count);
+    for (int i = 0; i < count; ++i) {
+        results.push_back(Results(r, table->where().greater_equal(col, i).less(col, i + 4)));
+        tokens.push_back(results.back().add_notification_callback([&calls, &changes, i](CollectionChangeSet c) {
+            ++calls[i];
+            changes[i] = std::move(c);
+        }));
+    }
+
+    auto in_range = [](int i, int64_t value) {
+        return value >= i && value < i + 4;
+    };
+
+    advance_and_notify(*r);
+    for (int i = 0; i < count; ++i) {
+        REQUIRE(calls[i] == 1);
+        REQUIRE(results[i].size() == 4);
+    }
+
+    SECTION("each notifier reports its own changes") {
+        r->begin_transaction();
+        table->get_object(5).set(col, 100);
+        table->create_object().set(col, 2);
+        r->commit_transaction();
+        advance_and_notify(*r);
+
+        for (int i = 0; i < count; ++i) {
+            bool deleted = in_range(i, 5);
+            bool inserted = in_range(i, 2);
+            REQUIRE(calls[i] == (deleted || inserted ? 2 : 1));
+            REQUIRE(results[i].size() == 4 - deleted + inserted);
+            if (deleted || inserted) {
+                REQUIRE(changes[i].deletions.count() == size_t(deleted));
+                REQUIRE(changes[i].insertions.count() == size_t(inserted));
+            }
+        }
+    }
+
+    SECTION("notifiers added later are run alongside the existing ones") {
+        Results later(r, table->where().greater_equal(col, 8));
+        int later_calls = 0;
+        auto later_token = later.add_notification_callback([&](CollectionChangeSet) {
+            ++later_calls;
+        });
+        advance_and_notify(*r);
+        REQUIRE(later_calls == 1);
+
+        r->begin_transaction();
+        table->create_object().set(col, 9);
+        r->commit_transaction();
+        advance_and_notify(*r);
+        REQUIRE(later_calls == 2);
+        REQUIRE(later.size() == 3);
+        REQUIRE(calls[6] == 2);
+    }
+
+    SECTION("skipping a notification only affects that callback") {
+        r->begin_transaction();
+        table->create_object().set(col, 3);
+        tokens[1].suppress_next();
+        r->commit_transaction();
+        advance_and_notify(*r);
+
+        for (int i = 0; i < count; ++i)
+            REQUIRE(calls[i] == (in_range(i, 3) && i != 1 ? 2 : 1));
+        REQUIRE(results[1].size() == 5);
+    }
+
+    SECTION("removing notifiers releases their transactions") {
+        tokens.clear();
+        results.clear();
+        advance_and_notify(*r);
+
+        Results all(r, table->where());
+        int all_calls = 0;
+        auto all_token = all.add_notification_callback([&](CollectionChangeSet) {
+            ++all_calls;
+        });
+        advance_and_notify(*r);
+        REQUIRE(all_calls == 1);
+        REQUIRE(all.size() == 10);
+    }
+}
+
 TEST_CASE("notifications: TableView delivery", "[notifications]") {
     _impl::RealmCoordinator::assert_no_open_realms();
 
@@ -1422,6 +1532,359 @@ TEST_CASE("notifications: TableView delivery", "[notifications]") {
 }
 
 
+TEST_CASE("notifications: incremental results update", "[notifications][results]") {
+    _impl::RealmCoordinator::assert_no_open_realms();
+    InMemoryTestFile config;
+    config.automatic_change_notifications = false;
+
+    auto r = Realm::get_shared_realm(config);
+    r->update_schema({
+        {"object", {{"value", PropertyType::Int}, {"name", PropertyType::String}}},
+    });
+
+    auto table = r->read_group().get_table("class_object");
+    auto col_value = table->get_column_key("value");
+    auto col_name = table->get_column_key("name");
+
+    r->begin_transaction();
+    for (int i = 0; i < 400; ++i)
+        table->create_object().set(col_value, i % 100).set(col_name, util::format("name %1", i % 7));
+    r->commit_transaction();
+
+    // Results in table order which only depend on the queried table are updated
+    // from the changed objects rather than by rerunning the query. Check that
+    // both the results and the reported changes match a full rerun.
+    auto query = GENERATE(as<std::string>{}, "value > 50", "value < 10 || name == 'name 3'", "TRUEPREDICATE");
+    Results results(r, table->query(query));
+    std::vector<ObjKey> previous;
+    CollectionChangeSet changes;
+    int calls = 0;
+    auto token = results.add_notification_callback([&](CollectionChangeSet c) {
+        changes = std::move(c);
+        ++calls;
+    });
+    advance_and_notify(*r);
+    REQUIRE(calls == 1);
+
+    auto keys_of = [](Results& results) {
+        std::vector<ObjKey> keys;
+        for (size_t i = 0; i < results.size(); ++i)
+            keys.push_back(results.get(i).get_key());
+        return keys;
+    };
+    auto expected_keys = [&] {
+        auto tv = table->query(query).find_all();
+        std::vector<ObjKey> keys;
+        for (size_t i = 0; i < tv.size(); ++i)
+            keys.push_back(tv.get_key(i));
+        return keys;
+    };
+    previous = keys_of(results);
+    REQUIRE(previous == expected_keys());
+
+    std::mt19937 rng(42);
+    for (int round = 0; round < 30; ++round) {
+        r->begin_transaction();
+        for (int i = 0; i < 5; ++i) {
+            auto obj = table->get_object(rng() % table->size());
+            switch (rng() % 4) {
+                case 0:
+                    obj.remove();
+                    break;
+                case 1:
+                    table->create_object().set(col_value, int64_t(rng() % 100));
+                    break;
+                case 2:
+                    obj.set(col_value, int64_t(rng() % 100));
+                    break;
+                case 3:
+                    obj.set(col_name, util::format("name %1", rng() % 7));
+                    break;
+            }
+        }
+        r->commit_transaction();
+        changes = {};
+        advance_and_notify(*r);
+
+        auto current = keys_of(results);
+        REQUIRE(current == expected_keys());
+
+        // Applying the reported changes to the previous results gives the new results
+        std::vector<ObjKey> applied;
+        for (size_t i = 0; i < previous.size(); ++i) {
+            if (!changes.deletions.contains(i))
+                applied.push_back(previous[i]);
+        }
+        for (auto i : changes.insertions.as_indexes()) {
+            REQUIRE(i <= applied.size());
+            applied.insert(applied.begin() + i, current[i]);
+        }
+        REQUIRE(applied == current);
+        previous = std::move(current);
+    }
+}
+
+TEST_CASE("notifications: incremental results update with links within one table", "[notifications][results]") {
+    _impl::RealmCoordinator::assert_no_open_realms();
+    InMemoryTestFile config;
+    config.automatic_change_notifications = false;
+
+    auto r = Realm::get_shared_realm(config);
+    r->update_schema({
+        {"person",
+         {{"age", PropertyType::Int},
+          {"parent", PropertyType::Object | PropertyType::Nullable, "person"},
+          {"friends", PropertyType::Array | PropertyType::Object, "person"}}},
+    });
+
+    auto table = r->read_group().get_table("class_person");
+    auto col_age = table->get_column_key("age");
+    auto col_parent = table->get_column_key("parent");
+    auto col_friends = table->get_column_key("friends");
+
+    r->begin_transaction();
+    std::vector<Obj> people;
+    for (int i = 0; i < 100; ++i)
+        people.push_back(table->create_object());
+    for (int i = 50; i < 100; ++i)
+        people[i].set(col_parent, people[0].get_key());
+    r->commit_transaction();
+
+    // The only dependency table is the queried table, but whether an object
+    // matches depends on other objects, so modifying one object can change
+    // whether unmodified objects match
+    SECTION("link to an object in the same table") {
+        Results results(r, table->query("parent.age > 5"));
+        CollectionChangeSet changes;
+        auto token = results.add_notification_callback([&](CollectionChangeSet c) {
+            changes = std::move(c);
+        });
+        advance_and_notify(*r);
+        REQUIRE(results.size() == 0);
+
+        r->begin_transaction();
+        people[0].set(col_age, 10);
+        r->commit_transaction();
+        advance_and_notify(*r);
+        REQUIRE(results.size() == 50);
+        REQUIRE(changes.insertions.count() == 50);
+    }
+
+    SECTION("backlink from an object in the same table") {
+        Results results(r, table->query("@links.person.friends.@count > 0"));
+        CollectionChangeSet changes;
+        auto token = results.add_notification_callback([&](CollectionChangeSet c) {
+            changes = std::move(c);
+        });
+        advance_and_notify(*r);
+        REQUIRE(results.size() == 0);
+
+        r->begin_transaction();
+        people[1].get_linklist(col_friends).add(people[2].get_key());
+        r->commit_transaction();
+        advance_and_notify(*r);
+        REQUIRE(results.size() == 1);
+        REQUIRE(results.get(0).get_key() == people[2].get_key());
+        REQUIRE_INDICES(changes.insertions, 0);
+    }
+}
+
+TEST_CASE("notifications: identical queries share an evaluation", "[notifications][results]") {
+    _impl::RealmCoordinator::assert_no_open_realms();
+    InMemoryTestFile config;
+    config.automatic_change_notifications = false;
+    config.cache = false;
+    config.max_notifier_threads = 2;
+    config.schema = Schema{
+        {"object", {{"value", PropertyType::Int}, {"name", PropertyType::String}}},
+    };
+
+    auto r1 = Realm::get_shared_realm(config);
+    auto r2 = Realm::get_shared_realm(config);
+    auto table1 = r1->read_group().get_table("class_object");
+    auto table2 = r2->read_group().get_table("class_object");
+    auto col_value = table1->get_column_key("value");
+    auto col_name = table1->get_column_key("name");
+
+    r1->begin_transaction();
+    for (int i = 0; i < 10; ++i)
+        table1->create_object().set(col_value, i);
+    r1->commit_transaction();
+    r2->refresh();
+
+    auto notify = [&] {
+        advance_and_notify(*r1);
+        advance_and_notify(*r2);
+    };
+
+    struct Observer {
+        Results results;
+        CollectionChangeSet changes;
+        int calls = 0;
+        NotificationToken token;
+    };
+    auto observe = [](Observer& observer, std::optional<KeyPathArray> key_paths = std::nullopt) {
+        observer.token = observer.results.add_notification_callback(
+            [&observer](CollectionChangeSet c) {
+                observer.changes = std::move(c);
+                ++observer.calls;
+            },
+            std::move(key_paths));
+    };
+
+    // The same query from two Realms, one of them only observing "name", plus
+    // a sorted version of the query which can't share the unsorted results
+    Observer a{Results(r1, table1->where().greater(col_value, 5))};
+    Observer b{Results(r2, table2->where().greater(col_value, 5))};
+    Observer c{Results(r2, table2->where().greater(col_value, 5))};
+    Observer sorted{Results(r1, table1->where().greater(col_value, 5)).sort({{"value", false}})};
+    observe(a);
+    observe(b);
+    observe(c, KeyPathArray{{{table2->get_key(), col_name}}});
+    observe(sorted);
+    notify();
+    REQUIRE(a.calls == 1);
+    REQUIRE(b.calls == 1);
+    REQUIRE(c.calls == 1);
+    REQUIRE(sorted.calls == 1);
+    REQUIRE(a.results.size() == 4);
+    REQUIRE(b.results.size() == 4);
+    REQUIRE(sorted.results.get(0).get<int64_t>(col_value) == 9);
+
+    SECTION("each subscriber gets the new results and its own changes") {
+        r1->begin_transaction();
+        table1->get_object(6).set(col_value, 0);
+        table1->get_object(8).set(col_value, 20);
+        r1->commit_transaction();
+        notify();
+
+        for (auto observer : {&a, &b}) {
+            REQUIRE(observer->calls == 2);
+            REQUIRE(observer->results.size() == 3);
+            REQUIRE_INDICES(observer->changes.deletions, 0);
+            REQUIRE_INDICES(observer->changes.modifications, 2);
+            REQUIRE_INDICES(observer->changes.modifications_new, 1);
+        }
+        // Only the value column was modified, which c isn't observing, but the
+        // removed object is still reported
+        REQUIRE(c.calls == 2);
+        REQUIRE(c.results.size() == 3);
+        REQUIRE_INDICES(c.changes.deletions, 0);
+        REQUIRE(c.changes.modifications.empty());
+
+        REQUIRE(sorted.calls == 2);
+        REQUIRE(sorted.results.size() == 3);
+        REQUIRE(sorted.results.get(0).get<int64_t>(col_value) == 20);
+    }
+
+    SECTION("a subscriber added later diffs against its own previous results") {
+        r1->begin_transaction();
+        table1->create_object().set(col_value, 7);
+        r1->commit_transaction();
+        notify();
+        REQUIRE(a.calls == 2);
+        REQUIRE(b.calls == 2);
+
+        Observer later{Results(r2, table2->where().greater(col_value, 5))};
+        observe(later);
+        notify();
+        REQUIRE(later.calls == 1);
+        REQUIRE(later.results.size() == 5);
+
+        r1->begin_transaction();
+        table1->create_object().set(col_value, 8);
+        r1->commit_transaction();
+        notify();
+        for (auto observer : {&a, &b, &later}) {
+            REQUIRE(observer->calls == (observer == &later ? 2 : 3));
+            REQUIRE(observer->results.size() == 6);
+            REQUIRE_INDICES(observer->changes.insertions, 5);
+            REQUIRE(observer->changes.deletions.empty());
+        }
+    }
+
+    SECTION("removing the subscriber which ran the query") {
+        a.token = {};
+        r1->begin_transaction();
+        table1->get_object(9).remove();
+        r1->commit_transaction();
+        notify();
+        REQUIRE(a.calls == 1);
+        REQUIRE(b.calls == 2);
+        REQUIRE(b.results.size() == 3);
+        REQUIRE_INDICES(b.changes.deletions, 3);
+    }
+}
+
+TEST_CASE("notifications: modifications through links with several notifiers", "[notifications][results]") {
+    _impl::RealmCoordinator::assert_no_open_realms();
+    InMemoryTestFile config;
+    config.automatic_change_notifications = false;
+
+    // Five tables where each object links to an object in the next table
+    const char* names[] = {"a", "b", "c", "d", "e"};
+    Schema schema;
+    std::vector<ObjectSchema> object_schemas;
+    for (int i = 0; i < 5; ++i) {
+        ObjectSchema os;
+        os.name = names[i];
+        os.persisted_properties = {{"value", PropertyType::Int}};
+        if (i < 4)
+            os.persisted_properties.push_back({"next", PropertyType::Object | PropertyType::Nullable, names[i + 1]});
+        object_schemas.push_back(std::move(os));
+    }
+    config.schema = Schema{object_schemas};
+    auto r = Realm::get_shared_realm(config);
+
+    std::vector<TableRef> tables;
+    for (auto name : names)
+        tables.push_back(r->read_group().get_table(util::format("class_%1", name)));
+    auto col_value = tables[0]->get_column_key("value");
+
+    r->begin_transaction();
+    std::vector<std::vector<Obj>> objs(5);
+    for (int i = 4; i >= 0; --i) {
+        for (int j = 0; j < 2; ++j) {
+            auto obj = tables[i]->create_object().set("value", j);
+            if (i < 4)
+                obj.set("next", objs[i + 1][j].get_key());
+            objs[i].push_back(obj);
+        }
+    }
+    r->commit_transaction();
+
+    // The notifiers share one search for the objects linking to modified
+    // objects, which has to give the same results as each searching itself
+    Results all(r, tables[0]->where());
+    Results first(r, tables[0]->where().equal(col_value, 0));
+    CollectionChangeSet all_changes, first_changes;
+    auto all_token = all.add_notification_callback([&](CollectionChangeSet c) {
+        all_changes = std::move(c);
+    });
+    auto first_token = first.add_notification_callback([&](CollectionChangeSet c) {
+        first_changes = std::move(c);
+    });
+    advance_and_notify(*r);
+
+    // Modifications are reported for objects up to three links away
+    r->begin_transaction();
+    objs[3][0].set("value", 10);
+    objs[4][1].set("value", 10);
+    r->commit_transaction();
+    advance_and_notify(*r);
+    REQUIRE_INDICES(all_changes.modifications, 0);
+    REQUIRE_INDICES(first_changes.modifications, 0);
+
+    r->begin_transaction();
+    objs[1][1].set("value", 10);
+    r->commit_transaction();
+    all_changes = {};
+    first_changes = {};
+    advance_and_notify(*r);
+    REQUIRE_INDICES(all_changes.modifications, 1);
+    REQUIRE(first_changes.empty());
+}
+
 #if REALM_ENABLE_SYNC
 TEST_CASE("notifications: sync", "[sync][pbs][notifications]") {
     _impl::RealmCoordinator::assert_no_open_realms();
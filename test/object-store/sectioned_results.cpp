@@ -770,7 +770,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         auto o6 = table->create_object().set(name_col, "any");
         r->commit_transaction();
         advance_and_notify(*r);
-        REQUIRE(algo_run_count == 11);
+        REQUIRE(algo_run_count == 6);
 
         REQUIRE(changes.sections_to_delete.empty());
         REQUIRE_INDICES(changes.sections_to_insert, 2, 3, 5);
@@ -807,7 +807,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE_INDICES(changes.modifications[5], 1);
         REQUIRE(changes.insertions.empty());
         REQUIRE(changes.deletions.empty());
-        REQUIRE(algo_run_count == 11);
+        REQUIRE(algo_run_count == 1);
 
         algo_run_count = 0;
         // Deletions
@@ -825,7 +825,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE_INDICES(changes.deletions[2], 1);
         REQUIRE(changes.insertions.empty());
         REQUIRE(changes.modifications.empty());
-        REQUIRE(algo_run_count == 9);
+        REQUIRE(algo_run_count == 0);
 
         // Test moving objects from one section to a new one.
         // delete all objects starting with 'S'
@@ -850,7 +850,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE(changes.insertions[2].empty());
         REQUIRE_INDICES(changes.insertions[3], 0, 1);
         REQUIRE_INDICES(changes.insertions[4], 0);
-        REQUIRE(algo_run_count == 9);
+        REQUIRE(algo_run_count == 3);
 
         // Test moving objects from one section to an existing one.
         // move all objects starting with 'E'
@@ -867,7 +867,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE(changes.insertions.size() == 1);
         REQUIRE(changes.modifications.empty());
         REQUIRE_INDICES(changes.insertions[0], 0, 5);
-        REQUIRE(algo_run_count == 9);
+        REQUIRE(algo_run_count == 2);
 
         // Test clearing all from the table
         algo_run_count = 0;
@@ -1232,7 +1232,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         auto o1 = table->create_object().set(name_col, "any");
         r->commit_transaction();
         advance_and_notify(*r);
-        REQUIRE(algo_run_count == 6);
+        REQUIRE(algo_run_count == 1);
 
         REQUIRE(section1_notification_calls == 1);
         REQUIRE(section2_notification_calls == 0);
@@ -1253,7 +1253,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE_INDICES(section2_changes.insertions[1], 1);
         REQUIRE(section2_changes.modifications.empty());
         REQUIRE(section2_changes.deletions.empty());
-        REQUIRE(algo_run_count == 7);
+        REQUIRE(algo_run_count == 1);
         algo_run_count = 0;
 
         // Modifications
@@ -1267,7 +1267,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE_INDICES(section1_changes.modifications[0], 0);
         REQUIRE(section1_changes.insertions.empty());
         REQUIRE(section1_changes.deletions.empty());
-        REQUIRE(algo_run_count == 7);
+        REQUIRE(algo_run_count == 1);
         algo_run_count = 0;
         // Modify the column value to now be in a diff section
         r->begin_transaction();
@@ -1279,7 +1279,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE(section1_changes.modifications.empty());
         REQUIRE(section1_changes.insertions.empty());
         REQUIRE_INDICES(section1_changes.deletions[0], 0);
-        REQUIRE(algo_run_count == 7);
+        REQUIRE(algo_run_count == 1);
         algo_run_count = 0;
 
         // Deletions
@@ -1294,7 +1294,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE_INDICES(section2_changes.deletions[1], 1);
         REQUIRE(section2_changes.insertions.empty());
         REQUIRE(section2_changes.modifications.empty());
-        REQUIRE(algo_run_count == 6);
+        REQUIRE(algo_run_count == 0);
         algo_run_count = 0;
 
         r->begin_transaction();
@@ -1307,7 +1307,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE_INDICES(section1_changes.deletions[0], 1);
         REQUIRE(section1_changes.insertions.empty());
         REQUIRE(section1_changes.modifications.empty());
-        REQUIRE(algo_run_count == 5);
+        REQUIRE(algo_run_count == 0);
     }
 
     SECTION("notifications on section where section is deleted") {
@@ -1351,17 +1351,17 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE(section1_changes.insertions.empty());
         REQUIRE(section1_changes.modifications.empty());
         REQUIRE_INDICES(section1_changes.sections_to_delete, 0);
-        REQUIRE(algo_run_count == 2);
+        REQUIRE(algo_run_count == 0);
 
         r->begin_transaction();
-        REQUIRE(algo_run_count == 2);
+        REQUIRE(algo_run_count == 0);
         algo_run_count = 0;
         section1_notification_calls = 0;
         section2_notification_calls = 0;
         table->create_object().set(name_col, "book");
         r->commit_transaction();
         advance_and_notify(*r);
-        REQUIRE(algo_run_count == 3);
+        REQUIRE(algo_run_count == 1);
 
         REQUIRE(section1_notification_calls == 0);
         REQUIRE(section2_notification_calls == 1);
@@ -1370,12 +1370,12 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE_INDICES(section2_changes.insertions[0], 1);
         REQUIRE(section2_changes.modifications.empty());
         REQUIRE(section2.index() == 0);
-        REQUIRE(algo_run_count == 3);
+        REQUIRE(algo_run_count == 1);
 
         // Insert values back into section1
         REQUIRE_FALSE(section1.is_valid());
         r->begin_transaction();
-        REQUIRE(algo_run_count == 3);
+        REQUIRE(algo_run_count == 1);
         algo_run_count = 0;
         section1_notification_calls = 0;
         section2_notification_calls = 0;
@@ -1383,7 +1383,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         r->commit_transaction();
         advance_and_notify(*r);
 
-        REQUIRE(algo_run_count == 4);
+        REQUIRE(algo_run_count == 1);
         REQUIRE(section1_notification_calls == 1);
         REQUIRE(section2_notification_calls == 0);
         REQUIRE(section1_changes.deletions.empty());
@@ -1395,6 +1395,81 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE(section1.is_valid());
     }
 
+    SECTION("notifications with key path filter recalculate all sections") {
+        auto int_col = table->get_column_key("int_col");
+        int run_count = 0;
+        auto unsorted = results.sectioned_results([&run_count](Mixed value, const SharedRealm& realm) {
+            run_count++;
+            auto obj = Object(realm, value.get_link());
+            auto v = obj.get_column_value<StringData>("name_col");
+            return v.prefix(1);
+        });
+
+        SectionedResultsChangeSet changes;
+        auto token = unsorted.add_notification_callback(
+            [&](SectionedResultsChangeSet c) {
+                changes = c;
+            },
+            KeyPathArray{{{table->get_key(), int_col}}});
+        advance_and_notify(*r);
+        REQUIRE(run_count == 5);
+        run_count = 0;
+
+        // Changes the section key without being reported to the callback
+        r->begin_transaction();
+        o5.set(name_col, "zebra");
+        r->commit_transaction();
+        advance_and_notify(*r);
+        REQUIRE(run_count == 0);
+
+        r->begin_transaction();
+        table->get_object(0).set(int_col, 10);
+        r->commit_transaction();
+        advance_and_notify(*r);
+        REQUIRE(run_count == 5);
+        REQUIRE(unsorted.size() == 4);
+        REQUIRE(unsorted[1].size() == 2);
+        REQUIRE(unsorted[3].key().get_string() == "z");
+        REQUIRE(unsorted[3].size() == 1);
+    }
+
+    SECTION("notifications after a suppressed notification recalculate all sections") {
+        auto int_col = table->get_column_key("int_col");
+        int run_count = 0;
+        auto unsorted = results.sectioned_results([&run_count](Mixed value, const SharedRealm& realm) {
+            run_count++;
+            auto obj = Object(realm, value.get_link());
+            auto v = obj.get_column_value<StringData>("name_col");
+            return v.prefix(1);
+        });
+
+        SectionedResultsChangeSet changes;
+        auto token = unsorted.add_notification_callback([&](SectionedResultsChangeSet c) {
+            changes = c;
+        });
+        advance_and_notify(*r);
+        REQUIRE(run_count == 5);
+        run_count = 0;
+
+        // Changes the section key in a write whose notification is skipped
+        r->begin_transaction();
+        o5.set(name_col, "zebra");
+        token.suppress_next();
+        r->commit_transaction();
+        advance_and_notify(*r);
+        REQUIRE(run_count == 0);
+
+        r->begin_transaction();
+        table->get_object(0).set(int_col, 10);
+        r->commit_transaction();
+        advance_and_notify(*r);
+        REQUIRE(run_count == 5);
+        REQUIRE(unsorted.size() == 4);
+        REQUIRE(unsorted[1].size() == 2);
+        REQUIRE(unsorted[3].key().get_string() == "z");
+        REQUIRE(unsorted[3].size() == 1);
+    }
+
     SECTION("snapshot") {
         auto sr_snapshot = sectioned_results.snapshot();
 
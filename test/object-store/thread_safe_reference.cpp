@@ -1116,3 +1116,153 @@ TEST_CASE("thread safe reference") {
         // test isn't applicable (and would be an infintie loop)
     }
 }
+
+TEST_CASE("thread safe reference batch") {
+    Schema schema{
+        {"int object",
+         {
+             {"value", PropertyType::Int},
+         }},
+        {"int array object", {{"value", PropertyType::Array | PropertyType::Object, "int object"}}},
+        {"int array", {{"value", PropertyType::Array | PropertyType::Int}}},
+    };
+
+    TestFile config;
+    config.automatic_change_notifications = false;
+    config.schema = schema;
+    config.in_memory = true;
+    config.encryption_key.clear();
+    auto r = Realm::get_shared_realm(config);
+
+    const auto int_obj_col = r->schema().find("int object")->persisted_properties[0].column_key;
+    auto table = get_table(*r, "int object");
+
+    r->begin_transaction();
+    std::vector<Object> objects;
+    for (int64_t i = 0; i < 10; ++i)
+        objects.push_back(create_object(r, "int object", {{"value", i}}));
+    auto int_list_obj = create_object(r, "int array", {{"value", AnyVector{INT64_C(1), INT64_C(2)}}});
+    auto int_list = List(int_list_obj, int_list_obj.get_object_schema().property_for_name("value"));
+    r->commit_transaction();
+
+    SECTION("resolves every value at the source version") {
+        ThreadSafeReferenceBatch batch;
+        std::vector<size_t> object_indexes;
+        for (auto& obj : objects)
+            object_indexes.push_back(batch.add(obj));
+        size_t list_index = batch.add(int_list);
+        size_t results_index = batch.add(Results(r, table->where().greater(int_obj_col, 4)));
+        size_t int_results_index = batch.add(int_list.as_results());
+        REQUIRE(batch.size() == 13);
+
+        r->begin_transaction();
+        for (auto& obj : objects)
+            obj.get_obj().set(int_obj_col, obj.get_obj().get<Int>(int_obj_col) + 100);
+        r->commit_transaction();
+
+        JoiningThread([&] {
+            config.scheduler = util::Scheduler::make_dummy();
+            SharedRealm r2 = Realm::get_shared_realm(config);
+            batch.resolve(r2);
+            for (int64_t i = 0; i < 10; ++i) {
+                auto obj = batch.get<Object>(object_indexes[i]);
+                REQUIRE(obj.is_valid());
+                REQUIRE(obj.get_object_schema().name == "int object");
+                REQUIRE(obj.get_obj().get<Int>(int_obj_col) == i);
+            }
+            REQUIRE(batch.get<List>(list_index).size() == 2);
+            REQUIRE(batch.get<Results>(results_index).size() == 5);
+            REQUIRE(batch.get<Results>(int_results_index).size() == 2);
+        });
+    }
+
+    SECTION("Results pin the source version until the batch is destroyed") {
+        auto history = make_in_realm_history();
+        auto db = DB::create(*history, config.path, config.options());
+        auto initial_version = db->get_version_id_of_latest_snapshot();
+
+        auto batch = util::make_optional<ThreadSafeReferenceBatch>();
+        batch->add(Results(r, table->where()));
+        batch->add(Results(r, table->where().greater(int_obj_col, 4)));
+
+        r->begin_transaction();
+        r->commit_transaction();
+        r->begin_transaction();
+        r->commit_transaction();
+        REQUIRE_NOTHROW(db->start_read(initial_version));
+
+        batch = util::none;
+        r->begin_transaction();
+        r->commit_transaction();
+        REQUIRE_THROWS_AS(db->start_read(initial_version), DB::BadVersion);
+    }
+
+    SECTION("deleted objects resolve to invalid accessors") {
+        ThreadSafeReferenceBatch batch;
+        size_t deleted_index = batch.add(objects[3]);
+        size_t list_index = batch.add(int_list);
+        size_t kept_index = batch.add(objects[4]);
+
+        r->begin_transaction();
+        objects[3].get_obj().remove();
+        int_list_obj.get_obj().remove();
+        r->commit_transaction();
+
+        batch.resolve(r);
+        REQUIRE_FALSE(batch.get<Object>(deleted_index).is_valid());
+        REQUIRE_FALSE(batch.get<List>(list_index).is_valid());
+        REQUIRE(batch.get<Object>(kept_index).get_obj().get<Int>(int_obj_col) == 4);
+    }
+
+    SECTION("values must come from the same version") {
+        ThreadSafeReferenceBatch batch;
+        batch.add(objects[0]);
+
+        r->begin_transaction();
+        objects[1].get_obj().set(int_obj_col, 100);
+        r->commit_transaction();
+
+        REQUIRE_EXCEPTION(batch.add(objects[1]), WrongTransactionState,
+                          "All values in a ThreadSafeReferenceBatch must come from the same Realm at the same version.");
+        REQUIRE(batch.size() == 1);
+    }
+
+    SECTION("get() rejects invalid indexes and types") {
+        ThreadSafeReferenceBatch batch;
+        REQUIRE_EXCEPTION(batch.get<Object>(0), OutOfBounds,
+                          "Requested index 0 calling ThreadSafeReferenceBatch::get() when empty");
+
+        size_t object_index = batch.add(objects[0]);
+        size_t list_index = batch.add(int_list);
+        REQUIRE_EXCEPTION(batch.get<Object>(object_index), OutOfBounds,
+                          "Requested index 0 calling ThreadSafeReferenceBatch::get() when empty");
+
+        batch.resolve(r);
+        REQUIRE(batch.get<Object>(object_index).is_valid());
+        REQUIRE_EXCEPTION(batch.get<Object>(2), OutOfBounds,
+                          "Requested index 2 calling ThreadSafeReferenceBatch::get() when max is 1");
+        REQUIRE_EXCEPTION(batch.get<List>(object_index), InvalidArgument,
+                          "ThreadSafeReferenceBatch value at index 0 is of type Object, not List.");
+        REQUIRE_EXCEPTION(batch.get<Results>(list_index), InvalidArgument,
+                          "ThreadSafeReferenceBatch value at index 1 is of type List, not Results.");
+    }
+
+    SECTION("resolving into a Realm without the object's type throws") {
+        ThreadSafeReferenceBatch batch;
+        size_t list_index = batch.add(int_list);
+        batch.resolve(r);
+
+        batch.add(objects[0]);
+        RealmConfig config2 = config;
+        config2.schema = Schema{{"int array", {{"value", PropertyType::Array | PropertyType::Int}}}};
+        JoiningThread([&] {
+            config2.scheduler = util::Scheduler::make_dummy();
+            SharedRealm r2 = Realm::get_shared_realm(config2);
+            REQUIRE_EXCEPTION(batch.resolve(r2), NoSuchTable,
+                              "Cannot resolve a ThreadSafeReferenceBatch containing an object of type 'int object' "
+                              "in a Realm whose schema does not include it.");
+        });
+        // The values from the previous resolve() are still usable
+        REQUIRE(batch.get<List>(list_index).size() == 2);
+    }
+}
@@ -2141,6 +2141,21 @@ TEST_CASE("DeepChangeChecker singular links", "[notifications]") {
                     verify_changes_for(checker, obj_indexes_with_changes);
                 }
 
+                SECTION("without filter - shared between checkers") {
+                    auto obj_indexes_with_changes = [](size_t ndx) {
+                        return ndx >= 16;
+                    };
+                    info.reachable_from_modified = std::make_unique<_impl::ModifiedObjectReachability>();
+                    info.reachable_from_modified->add_user();
+                    info.reachable_from_modified->add_user();
+                    info.reachable_from_modified->add_related_table(table->get_key());
+                    _impl::DeepChangeChecker checker1(info, *table, related_tables, key_path_array_empty, false);
+                    _impl::DeepChangeChecker checker2(info, *table, related_tables, key_path_array_empty, false);
+                    verify_changes_for(checker1, obj_indexes_with_changes);
+                    verify_changes_for(checker2, obj_indexes_with_changes);
+                    REQUIRE(info.reachable_from_modified->contains(table->get_key(), objects[16].get_key()));
+                }
+
                 SECTION("with filter - more than 4 levels deep") {
                     auto obj_indexes_with_changes = [](size_t ndx) {
                         return ndx == 15;
@@ -2171,6 +2186,18 @@ TEST_CASE("DeepChangeChecker singular links", "[notifications]") {
                     verify_changes_for(checker, obj_indexes_with_changes);
                 }
 
+                SECTION("without filter - shared between checkers") {
+                    auto obj_indexes_with_changes = [](size_t ndx) {
+                        return ndx >= 18;
+                    };
+                    info.reachable_from_modified = std::make_unique<_impl::ModifiedObjectReachability>();
+                    info.reachable_from_modified->add_user();
+                    info.reachable_from_modified->add_user();
+                    info.reachable_from_modified->add_related_table(table->get_key());
+                    _impl::DeepChangeChecker checker(info, *table, related_tables, key_path_array_empty, false);
+                    verify_changes_for(checker, obj_indexes_with_changes);
+                }
+
                 SECTION("with filter - none along complete path") {
                     auto obj_indexes_with_changes = [](size_t) {
                         return false;
@@ -425,6 +425,10 @@ public:
 
         long server_max_open_files = 64;
 
+        int server_num_workers = 1;
+
+        bool server_enable_download_bootstrap_cache = false;
+
         bool enable_server_ssl = false;
 
         std::string server_ssl_certificate_path = get_test_resource_path() + "test_sync_ca.pem";
@@ -433,6 +437,7 @@ public:
         bool disable_upload_compaction = false;
 
         bool disable_history_compaction = false;
+        std::size_t history_compaction_window = 64; // As in Server::Config
         std::chrono::seconds history_ttl = std::chrono::seconds::max();
         std::chrono::seconds history_compaction_interval = std::chrono::seconds{3600};
         const Clock* history_compaction_clock = nullptr;
@@ -516,6 +521,8 @@ public:
                 public_key = PKey::load_public(config.server_public_key_path);
             Server::Config config_2;
             config_2.max_open_files = config.server_max_open_files;
+            config_2.num_workers = config.server_num_workers;
+            config_2.enable_download_bootstrap_cache = config.server_enable_download_bootstrap_cache;
             config_2.logger = m_server_loggers[i];
             config_2.token_expiration_clock = &m_fake_token_expiration_clock;
             config_2.ssl = m_enable_server_ssl;
@@ -524,6 +531,8 @@ public:
             config_2.connection_reaper_timeout = config.server_connection_reaper_timeout;
             config_2.connection_reaper_interval = config.server_connection_reaper_interval;
             config_2.max_download_size = config.max_download_size;
+            config_2.history_compaction_window =
+                (config.disable_history_compaction ? 0 : config.history_compaction_window);
             config_2.tcp_no_delay = true;
             config_2.authorization_header_name = config.authorization_header_name;
             config_2.encryption_key = config.server_encryption_key;
@@ -455,4 +455,72 @@ TEST(BPlusTree_UpgradeFromArray)
     }
 }
 
+
+TEST(BPlusTree_EraseFront)
+{
+    // Trees of height one, two and three
+    const size_t node_size = REALM_MAX_BPNODE_SIZE;
+    for (size_t sz : {node_size / 2, 10 * node_size + 7, node_size * node_size + 3 * node_size}) {
+        BPlusTree<Int> tree(Allocator::get_default());
+        tree.create();
+        for (size_t i = 0; i < sz; i++) {
+            tree.add(int64_t(i));
+        }
+        // Inserting in the middle takes the inner nodes out of compact form
+        tree.insert(sz / 2, -1);
+
+        std::vector<int64_t> ref_arr = tree.get_all();
+        size_t begin = 0;
+        for (size_t n : {size_t(0), size_t(1), node_size - 1, node_size + 1, 3 * node_size, sz / 3, sz / 2}) {
+            n = std::min(n, ref_arr.size() - begin - 1);
+            tree.erase_front(n);
+            begin += n;
+            CHECK_EQUAL(tree.size(), ref_arr.size() - begin);
+            CHECK_EQUAL(tree.get(0), ref_arr[begin]);
+            CHECK_EQUAL(tree.get(tree.size() - 1), ref_arr.back());
+            tree.verify();
+        }
+        CHECK(tree.get_all() == std::vector<int64_t>(ref_arr.begin() + begin, ref_arr.end()));
+
+        // Appending after trimming
+        tree.add(17);
+        CHECK_EQUAL(tree.get(tree.size() - 1), 17);
+
+        tree.erase_front(tree.size());
+        CHECK(tree.is_empty());
+        tree.add(42);
+        CHECK_EQUAL(tree.size(), 1);
+        CHECK_EQUAL(tree.get(0), 42);
+        tree.destroy();
+    }
+}
+
+TEST(BinaryColumn_EraseFront)
+{
+    std::vector<std::string> ref_arr;
+    BinaryColumn c(Allocator::get_default());
+    c.create();
+    for (size_t i = 0; i < 5 * REALM_MAX_BPNODE_SIZE; i++) {
+        std::string str = util::to_string(i);
+        // Mix small and big blobs
+        if (i % 7 == 0)
+            str.append(100, 'x');
+        c.add(BinaryData(str));
+        ref_arr.push_back(str);
+    }
+
+    size_t begin = 0;
+    while (begin < ref_arr.size()) {
+        size_t n = std::min(size_t(1 + fastrand(2 * REALM_MAX_BPNODE_SIZE)), ref_arr.size() - begin);
+        c.erase_front(n);
+        begin += n;
+        CHECK_EQUAL(c.size(), ref_arr.size() - begin);
+        for (size_t i = 0; i < c.size(); i++) {
+            CHECK_EQUAL(c.get(i), BinaryData(ref_arr[begin + i]));
+        }
+        c.verify();
+    }
+    c.destroy();
+}
+
 #endif // TEST_BPLUS_TREE
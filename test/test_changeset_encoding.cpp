@@ -441,4 +441,33 @@ TEST(ChangesetParser_BadInternString_InvalidUse)
     CHECK_BADCHANGESET(buffer, "Invalid interned string");
 }
 
+TEST(Changeset_ShareStrings)
+{
+    Changeset original;
+    sync::InternString table = original.intern_string("Table");
+
+    Changeset shared;
+    shared.share_strings(original);
+    CHECK(shared.shares_strings());
+    CHECK_EQUAL(shared.get_string(table), "Table");
+    CHECK(std::as_const(shared).interned_strings() == original.interned_strings());
+
+    // Finding a string which is already interned does not copy the strings.
+    CHECK(shared.intern_string("Table") == table);
+    CHECK(shared.shares_strings());
+
+    // Strings shared from a sharing changeset are read from the owner.
+    Changeset shared_2;
+    shared_2.share_strings(shared);
+    CHECK(&std::as_const(shared_2).string_buffer() == &std::as_const(original).string_buffer());
+
+    // Interning a new string copies the strings before modifying them.
+    sync::InternString field = shared.intern_string("field");
+    CHECK_NOT(shared.shares_strings());
+    CHECK_EQUAL(shared.get_string(table), "Table");
+    CHECK_EQUAL(shared.get_string(field), "field");
+    CHECK_EQUAL(original.interned_strings().size(), 1);
+    CHECK_NOT(original.find_string("field"));
+}
+
 } // namespace
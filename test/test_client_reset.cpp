@@ -1646,7 +1646,7 @@ void apply_changes(DB& src, DB& dst)
         decompressed_changesets.emplace_back();
         auto& buffer = decompressed_changesets.back();
         ChunkedBinaryInputStream is{change.changeset};
-        util::compression::decompress_nonportable(is, buffer);
+        util::compression::decompress_nonportable(is, buffer, change.compression_dictionary);
 
         // Arbitrary non-zero file ident
         file_ident_type file_ident = 2;
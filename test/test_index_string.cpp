@@ -25,6 +25,7 @@
 #include <realm/tokenizer.hpp>
 #include <realm/util/to_string.hpp>
 #include <set>
+#include <thread>
 #include "test.hpp"
 #include "util/misc.hpp"
 #include "util/random.hpp"
@@ -283,6 +284,26 @@ TEST(Tokenizer_Basic)
     CHECK(tok->get_all_tokens() == std::set<std::string>({"with", "hyphen", "term", "other", "plus"}));
 }
 
+TEST(Tokenizer_ThreadInstance)
+{
+    auto& tok = realm::Tokenizer::get_thread_instance();
+    CHECK_EQUAL(&tok, &realm::Tokenizer::get_thread_instance());
+
+    tok.reset("Hello World");
+    CHECK(tok.get_all_tokens() == std::set<std::string>({"hello", "world"}));
+    // Reusing the instance starts over on the new text
+    tok.reset("-world hello");
+    auto [includes, excludes] = tok.get_search_tokens();
+    CHECK(includes == std::set<std::string>({"hello"}));
+    CHECK(excludes == std::set<std::string>({"world"}));
+
+    realm::Tokenizer* other_thread_tok = nullptr;
+    std::thread([&] {
+        other_thread_tok = &realm::Tokenizer::get_thread_instance();
+    }).join();
+    CHECK_NOT_EQUAL(other_thread_tok, &tok);
+}
+
 TEST(StringIndex_NonIndexable)
 {
     // Create a column with string values
@@ -49,6 +49,21 @@ struct Fixture {
         wt.commit();
     }
 
+    // Apply each instruction as soon as it has been parsed, and return the
+    // changeset used to hold the interned strings.
+    Changeset replay_transactions_streaming()
+    {
+        Changeset log;
+        const auto& buffer = history_1->get_instruction_encoder().buffer();
+        util::SimpleInputStream stream{buffer};
+
+        WriteTransaction wt{sg_2};
+        InstructionApplier applier{wt};
+        applier.parse_and_apply(stream, log);
+        wt.commit();
+        return log;
+    }
+
     void check_equal()
     {
         ReadTransaction rt_1{sg_1};
@@ -679,3 +694,90 @@ TEST(InstructionReplication_Dictionary)
         CHECK_EQUAL(dict.get("d"), true);
     }
 }
+
+TEST(InstructionReplication_Streaming)
+{
+    Fixture fixture{test_context};
+    {
+        WriteTransaction wt{fixture.sg_1};
+        TableRef foo = wt.get_group().add_table_with_primary_key("class_foo", type_String, "id");
+        ColKey col_name = foo->add_column(type_String, "name");
+        ColKey col_data = foo->add_column(type_Binary, "data", true);
+        ColKey col_list = foo->add_column_list(type_String, "tags");
+        for (int i = 0; i < 100; ++i) {
+            Obj obj = foo->create_object_with_primary_key(util::format("object %1", i));
+            std::string name(size_t(i), 'x');
+            obj.set(col_name, StringData{name});
+            obj.set(col_data, BinaryData{name.data(), name.size()});
+            auto tags = obj.get_list<String>(col_list);
+            tags.add("a");
+            tags.add(StringData{name});
+        }
+        wt.commit();
+    }
+    Changeset log = fixture.replay_transactions_streaming();
+    fixture.check_equal();
+
+    // Only the interned strings (class, property names and primary keys) are
+    // kept after all instructions have been applied.
+    size_t interned_size = 0;
+    for (auto& range : log.interned_strings())
+        interned_size += range.size;
+    CHECK_EQUAL(log.string_buffer().size(), interned_size);
+    CHECK(log.empty());
+}
+
+TEST(InstructionReplication_StreamingBadChangeset)
+{
+    Fixture fixture{test_context};
+    {
+        WriteTransaction wt{fixture.sg_1};
+        TableRef foo = wt.get_group().add_table_with_primary_key("class_foo", type_Int, "id");
+        foo->create_object_with_primary_key(1);
+        wt.commit();
+    }
+    {
+        // Truncate the last instruction
+        auto& buffer = fixture.history_1->get_instruction_encoder().buffer();
+        buffer.resize(buffer.size() - 1);
+    }
+    CHECK_THROW(fixture.replay_transactions_streaming(), BadChangesetError);
+}
+
+TEST(InstructionReplication_ReplaceColumn)
+{
+    // The applier caches column keys by name, which must not survive the
+    // column being removed and added again with a different type.
+    Fixture fixture{test_context};
+    {
+        WriteTransaction wt{fixture.sg_1};
+        TableRef foo = wt.get_group().add_table_with_primary_key("class_foo", type_Int, "id");
+        TableRef bar = wt.get_group().add_table_with_primary_key("class_bar", type_Int, "id");
+        ColKey col_value = foo->add_column(type_Int, "value");
+        ColKey col_link = foo->add_column(*bar, "link");
+        Obj target = bar->create_object_with_primary_key(7);
+        for (int64_t i = 0; i < 3; ++i) {
+            Obj obj = foo->create_object_with_primary_key(i);
+            obj.set(col_value, i);
+            obj.set(col_link, target.get_key());
+        }
+        foo->remove_column(col_value);
+        col_value = foo->add_column(type_String, "value");
+        for (int64_t i = 0; i < 3; ++i) {
+            foo->get_object_with_primary_key(i).set(col_value, "replaced");
+        }
+        wt.commit();
+    }
+    fixture.replay_transactions();
+    fixture.check_equal();
+    {
+        ReadTransaction rt{fixture.sg_2};
+        auto foo = rt.get_table("class_foo");
+        ColKey col_value = foo->get_column_key("value");
+        CHECK_EQUAL(col_value.get_type(), col_type_String);
+        for (auto& obj : *foo) {
+            CHECK_EQUAL(obj.get<String>(col_value), "replaced");
+            CHECK_EQUAL(obj.get_linked_object(foo->get_column_key("link")).get_primary_key(), Mixed(7));
+        }
+    }
+}
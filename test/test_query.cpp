@@ -5795,4 +5795,56 @@ TEST(Query_NestedLinkCount)
     CHECK_EQUAL(q.count(), 3);
 }
 
+TEST(Query_EvalObjects)
+{
+    Table table;
+    auto col_int = table.add_column(type_Int, "int");
+    auto col_str = table.add_column(type_String, "str");
+    table.add_search_index(col_str);
+    std::vector<ObjKey> keys;
+    for (int i = 0; i < 100; ++i)
+        keys.push_back(table.create_object().set(col_int, i).set(col_str, i % 3 ? "a" : "b").get_key());
+
+    Query q = table.where().greater(col_int, 10).equal(col_str, "b");
+    std::vector<ObjKey> candidates = {keys[0], keys[12], keys[13], keys[99], keys[50]};
+    table.remove_object(keys[99]);
+    auto matching = q.eval_objects(candidates);
+    CHECK_EQUAL(matching.size(), 1);
+    CHECK_EQUAL(matching[0], keys[12]);
+    CHECK_EQUAL(table.where().eval_objects(candidates).size(), 4);
+
+    // A view can be given the result instead of running the query
+    TableView tv(q, size_t(-1));
+    tv.set_query_result(matching);
+    CHECK(tv.is_in_sync());
+    CHECK_EQUAL(tv.size(), 1);
+    CHECK_EQUAL(tv.get_key(0), keys[12]);
+    table.get_object(keys[15]).set(col_str, "b");
+    CHECK_NOT(tv.is_in_sync());
+    tv.sync_if_needed();
+    CHECK_EQUAL(tv.size(), q.count());
+}
+
+TEST(Query_FollowsLinks)
+{
+    Group g;
+    auto table = g.add_table("person");
+    auto col_age = table->add_column(type_Int, "age");
+    auto col_parent = table->add_column(*table, "parent");
+    auto col_friends = table->add_column_list(*table, "friends");
+
+    CHECK_NOT(table->where().follows_links());
+    CHECK_NOT(table->where().greater(col_age, 5).follows_links());
+    CHECK_NOT(table->where().equal(col_parent, Mixed()).follows_links());
+    CHECK((table->link(col_parent).column<Int>(col_age) > 5).follows_links());
+    CHECK((table->backlink(*table, col_friends).column<Int>(col_age) > 5).follows_links());
+    CHECK((table->column<BackLink>(*table, col_friends).count() > 0).follows_links());
+    CHECK((table->where().greater(col_age, 5) || table->link(col_parent).column<Int>(col_age) > 5).follows_links());
+
+    // Following links does not add the queried table as an outside dependency
+    TableVersions versions;
+    (table->link(col_parent).column<Int>(col_age) > 5).get_outside_versions(versions);
+    CHECK_EQUAL(versions.size(), 1);
+}
+
 #endif // TEST_QUERY
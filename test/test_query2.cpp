@@ -3159,6 +3159,209 @@ TEST(Query_CompareThroughUnaryLinks)
     CHECK_EQUAL(k2, tv.get_key(0));
 }
 
+TEST(Query_CompareThroughLinksFromTargetTable)
+{
+    // Selective comparisons through links are evaluated on the smaller target table and
+    // mapped back through the backlinks. Check that the result is the same as when
+    // following the links from every origin object.
+    Group group;
+    TableRef cities = group.add_table("City");
+    auto col_name = cities->add_column(type_String, "name");
+    auto col_pop = cities->add_column(type_Int, "population", true);
+    TableRef people = group.add_table("Person");
+    auto col_city = people->add_column(*cities, "city");
+    auto col_visited = people->add_column_list(*cities, "visited");
+
+    std::vector<ObjKey> city_keys;
+    for (int i = 0; i < 10; ++i) {
+        auto city = cities->create_object().set(col_name, util::format("city%1", i));
+        if (i != 5)
+            city.set(col_pop, i);
+        city_keys.push_back(city.get_key());
+    }
+    for (int i = 0; i < 200; ++i) {
+        auto person = people->create_object();
+        if (i % 7)
+            person.set(col_city, city_keys[i % 10]);
+        auto visited = person.get_linklist(col_visited);
+        for (int j = 0; j < i % 4; ++j)
+            visited.add(city_keys[(i + j * 3) % 10]);
+    }
+
+    auto count_matching = [&](auto&& pred) {
+        size_t count = 0;
+        for (auto person : *people) {
+            if (pred(person))
+                ++count;
+        }
+        return count;
+    };
+    auto city_of = [&](const Obj& person) {
+        return person.get_linked_object(col_city);
+    };
+
+    Query q = people->link(col_city).column<String>(col_name) == "city3";
+    CHECK_EQUAL(q.count(), count_matching([&](const Obj& p) {
+                    auto c = city_of(p);
+                    return c && c.get<String>(col_name) == "city3";
+                }));
+
+    q = people->link(col_city).column<Int>(col_pop) > 7;
+    CHECK_EQUAL(q.count(), count_matching([&](const Obj& p) {
+                    auto c = city_of(p);
+                    return c && !c.is_null(col_pop) && c.get<Int>(col_pop) > 7;
+                }));
+
+    // Null links match, so this must follow the links
+    q = people->link(col_city).column<Int>(col_pop) != 3;
+    CHECK_EQUAL(q.count(), count_matching([&](const Obj& p) {
+                    auto c = city_of(p);
+                    return !c || c.is_null(col_pop) || c.get<Int>(col_pop) != 3;
+                }));
+
+    auto visited_any = [&](const Obj& p, auto&& pred) {
+        auto visited = p.get_linklist(col_visited);
+        for (size_t i = 0; i < visited.size(); ++i) {
+            if (pred(visited.get_object(i)))
+                return true;
+        }
+        return false;
+    };
+    q = people->link(col_visited).column<String>(col_name).begins_with("city1");
+    CHECK_EQUAL(q.count(), count_matching([&](const Obj& p) {
+                    return visited_any(p, [&](const Obj& c) {
+                        return c.get<String>(col_name) == "city1";
+                    });
+                }));
+
+    q = people->where().links_to(col_city, city_keys[1]).and_query(people->link(col_visited).column<Int>(col_pop) == 4);
+    CHECK_EQUAL(q.count(), count_matching([&](const Obj& p) {
+                    return p.get<ObjKey>(col_city) == city_keys[1] && visited_any(p, [&](const Obj& c) {
+                               return !c.is_null(col_pop) && c.get<Int>(col_pop) == 4;
+                           });
+                }));
+
+    // Changes to the target table are seen when the query is run again
+    q = people->link(col_city).column<String>(col_name) == "city3";
+    size_t before = q.count();
+    cities->get_object(city_keys[4]).set(col_name, "city3");
+    CHECK_EQUAL(q.count(), before + count_matching([&](const Obj& p) {
+                               return p.get<ObjKey>(col_city) == city_keys[4];
+                           }));
+}
+
+TEST(Query_CompareThroughLinksLargeTargetTable)
+{
+    // The target table is larger than the sample taken before scanning it. Both a
+    // selective and a non-selective condition must give the same result as following
+    // the links.
+    Group group;
+    TableRef cities = group.add_table("City");
+    auto col_pop = cities->add_column(type_Int, "population");
+    TableRef people = group.add_table("Person");
+    auto col_city = people->add_column(*cities, "city");
+
+    std::vector<ObjKey> city_keys;
+    for (int i = 0; i < 500; ++i)
+        city_keys.push_back(cities->create_object().set(col_pop, i).get_key());
+    for (int i = 0; i < 1000; ++i) {
+        auto person = people->create_object();
+        if (i % 3)
+            person.set(col_city, city_keys[(i * 7) % 500]);
+    }
+
+    auto count_matching = [&](auto&& pred) {
+        size_t count = 0;
+        for (auto person : *people) {
+            auto city = person.get_linked_object(col_city);
+            if (city && pred(city.get<Int>(col_pop)))
+                ++count;
+        }
+        return count;
+    };
+
+    Query q = people->link(col_city).column<Int>(col_pop) == 17;
+    CHECK_EQUAL(q.count(), count_matching([](int64_t pop) {
+                    return pop == 17;
+                }));
+    q = people->link(col_city).column<Int>(col_pop) >= 10;
+    CHECK_EQUAL(q.count(), count_matching([](int64_t pop) {
+                    return pop >= 10;
+                }));
+    q = people->link(col_city).column<Int>(col_pop) < 5;
+    CHECK_EQUAL(q.count(), count_matching([](int64_t pop) {
+                    return pop < 5;
+                }));
+}
+
+TEST(Query_ExpressionChunkMatches)
+{
+    // Column to column comparisons evaluate a chunk of rows at a time and answer the
+    // following calls for rows in that chunk from the cached matches. Check both sparse and
+    // dense matches across chunk and cluster boundaries.
+    Table table;
+    auto col_a = table.add_column(type_Int, "a");
+    auto col_b = table.add_column(type_Int, "b", true);
+    auto col_d = table.add_column(type_Double, "d");
+
+    const int num_rows = 1500;
+    for (int i = 0; i < num_rows; ++i) {
+        auto obj = table.create_object().set(col_a, i % 13).set(col_d, double(i % 5));
+        if (i % 11)
+            obj.set(col_b, i % 7);
+    }
+
+    auto check = [&](Query q, auto&& pred) {
+        std::vector<ObjKey> expected;
+        for (auto obj : table) {
+            if (pred(obj))
+                expected.push_back(obj.get_key());
+        }
+        auto tv = q.find_all();
+        CHECK_EQUAL(tv.size(), expected.size());
+        for (size_t i = 0; i < std::min(tv.size(), expected.size()); ++i)
+            CHECK_EQUAL(tv.get_key(i), expected[i]);
+        CHECK_EQUAL(q.count(), expected.size());
+        CHECK_EQUAL(q.find(), expected.empty() ? ObjKey() : expected.front());
+    };
+    auto b_of = [&](const Obj& obj) {
+        return obj.get<util::Optional<Int>>(col_b);
+    };
+
+    // Dense
+    check(table.column<Int>(col_a) > table.column<Int>(col_b), [&](const Obj& obj) {
+        auto b = b_of(obj);
+        return b && obj.get<Int>(col_a) > *b;
+    });
+    // Sparse
+    check(table.query("a == b + 6"), [&](const Obj& obj) {
+        auto b = b_of(obj);
+        return b && obj.get<Int>(col_a) == *b + 6;
+    });
+    check(table.query("a * 2 < d - 3"), [&](const Obj& obj) {
+        return obj.get<Int>(col_a) * 2 < obj.get<Double>(col_d) - 3;
+    });
+    // Nulls compare equal to each other
+    check(table.column<Int>(col_b) == table.column<Int>(col_b), [&](const Obj&) {
+        return true;
+    });
+    check(table.column<Int>(col_a) != table.column<Int>(col_b), [&](const Obj& obj) {
+        auto b = b_of(obj);
+        return !b || obj.get<Int>(col_a) != *b;
+    });
+    // No matches
+    check(table.column<Int>(col_a) > table.column<Int>(col_a), [&](const Obj&) {
+        return false;
+    });
+
+    // Combined with other conditions, which makes the expression start at arbitrary rows
+    check(table.where().equal(col_d, 2.0).and_query(table.column<Int>(col_a) >= table.column<Int>(col_b)),
+          [&](const Obj& obj) {
+              auto b = b_of(obj);
+              return obj.get<Double>(col_d) == 2.0 && b && obj.get<Int>(col_a) >= *b;
+          });
+}
+
 TEST(Query_DeepLink)
 {
 
@@ -295,6 +295,28 @@ TEST(Geospatial_Circle)
     CHECK_EQUAL((query && table->column<Int>(id_col) == 3).count(), 0);
 }
 
+TEST(Geospatial_BoundingRectangleWraparound)
+{
+    // Regions whose bounding rectangle wraps the antimeridian or includes a pole must
+    // not have points pruned that are inside the region.
+    Group g;
+    std::vector<Geospatial> points = {GeoPoint{-178.0, 0.0}, GeoPoint{178.0, 0.0}, GeoPoint{170.0, 0.0},
+                                      GeoPoint{10.0, 89.0},  GeoPoint{-170.0, 89.5}, GeoPoint{0.0, 80.0}};
+    TableRef table = setup_with_points(g, points);
+    ColKey location_column_key = table->get_column_key("location");
+    ColKey id_col = table->get_primary_key_column();
+
+    Query across_antimeridian =
+        table->column<Link>(location_column_key).geo_within(GeoCircle::from_kms(500, GeoPoint{180.0, 0.0}));
+    CHECK_EQUAL(across_antimeridian.count(), 2);
+    CHECK_EQUAL((across_antimeridian && table->column<Int>(id_col) == 2).count(), 0);
+
+    Query around_pole =
+        table->column<Link>(location_column_key).geo_within(GeoCircle::from_kms(500, GeoPoint{0.0, 90.0}));
+    CHECK_EQUAL(around_pole.count(), 2);
+    CHECK_EQUAL((around_pole && table->column<Int>(id_col) == 5).count(), 0);
+}
+
 TEST(Geospatial_GeoWithinShapes)
 {
     Group g;
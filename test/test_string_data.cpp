@@ -444,6 +444,60 @@ TEST(StringData_Substrings)
 }
 
 
+
+TEST(StringData_ContainsVectorized)
+{
+    // Haystacks long enough to be searched 16 positions at a time. Compare against
+    // std::search for needles placed at every position, including the last ones that
+    // are handled by the scalar tail.
+    auto make_charmap = [](StringData needle) {
+        std::array<uint8_t, 256> charmap{};
+        size_t last_char_pos = needle.size() - 1;
+        for (size_t i = 0; i < last_char_pos; ++i) {
+            uint8_t jump = last_char_pos - i < 255 ? static_cast<uint8_t>(last_char_pos - i) : 255;
+            charmap[static_cast<unsigned char>(needle[i])] = jump;
+        }
+        return charmap;
+    };
+
+    for (std::string needle : {"a", "xy", "abc", "needle", "0123456789abcdef", "0123456789abcdefg"}) {
+        auto charmap = make_charmap(needle);
+        for (size_t size = needle.size(); size < 80; ++size) {
+            for (size_t pos = 0; pos + needle.size() <= size; pos += 3) {
+                std::string haystack(size, '-');
+                haystack.replace(pos, needle.size(), needle);
+                StringData sd(haystack);
+                CHECK(sd.contains(needle, charmap));
+                CHECK(sd.contains(needle));
+                // Only the first and last byte match
+                std::string near_miss = needle;
+                if (needle.size() > 2) {
+                    near_miss[1] = '-';
+                    haystack.replace(pos, needle.size(), near_miss);
+                    CHECK_NOT(StringData(haystack).contains(needle, charmap));
+                }
+            }
+        }
+    }
+}
+
+TEST(StringData_ContainsVectorized_CaseInsensitive)
+{
+    std::string haystack(100, '.');
+    for (std::string needle : {"Needle", "søren", "ÆBLE", "x"}) {
+        auto upper = case_map(needle, true);
+        auto lower = case_map(needle, false);
+        CHECK(upper && lower);
+        for (size_t pos = 0; pos + needle.size() <= haystack.size(); ++pos) {
+            std::string h = haystack;
+            // Alternate the case of the inserted copy
+            h.replace(pos, needle.size(), pos % 2 ? *upper : *lower);
+            CHECK_EQUAL(search_case_fold(h, upper->c_str(), lower->c_str(), needle.size()), pos);
+        }
+        CHECK_EQUAL(search_case_fold(haystack, upper->c_str(), lower->c_str(), needle.size()), haystack.size());
+    }
+}
+
 TEST(StringData_STL_String)
 {
     const char* pre = "hilbert";
@@ -134,7 +134,8 @@ Changeset get_reciprocal_changeset(ClientHistory& hist, version_type version)
     ChunkedBinaryInputStream in{data};
     if (is_compressed) {
         size_t total_size;
-        auto decompressed = util::compression::decompress_nonportable_input_stream(in, total_size);
+        auto decompressed =
+            util::compression::decompress_nonportable_input_stream(in, total_size, hist.get_compression_dictionary());
         sync::parse_changeset(*decompressed, reciprocal_changeset); // Throws
     }
     else {
@@ -2252,6 +2253,111 @@ TEST_IF(Sync_ReadOnlyClient, false)
 }
 
 
+TEST(Sync_ServerWithMultipleWorkers)
+{
+    // Files are spread over the workers by their virtual path, so that changes
+    // to different files are integrated concurrently. Two clients change each
+    // file at the same time, so each worker also has to merge their changes.
+    constexpr int num_files = 8;
+    constexpr int num_transactions = 20;
+
+    TEST_DIR(dir);
+    ClientServerFixture::Config config;
+    config.server_num_workers = 4;
+    ClientServerFixture fixture(dir, test_context, std::move(config));
+    fixture.start();
+
+    std::vector<DBTestPathGuard> path_guards;
+    std::vector<DBRef> dbs;
+    std::vector<Session> sessions;
+    for (int i = 0; i < 2 * num_files; ++i) {
+        std::string path = get_test_path(test_context.get_test_name(), std::to_string(i));
+        path_guards.emplace_back(path);
+        dbs.push_back(DB::create(make_client_replication(), path));
+        sessions.push_back(fixture.make_bound_session(dbs.back(), "/file_" + std::to_string(i / 2)));
+    }
+
+    for (int j = 0; j < num_transactions; ++j) {
+        for (int i = 0; i < 2 * num_files; ++i) {
+            WriteTransaction wt{dbs[i]};
+            TableRef table = wt.get_group().get_table("class_Table");
+            if (!table) {
+                table = wt.get_group().add_table_with_primary_key("class_Table", type_Int, "id");
+                table->add_column(type_Int, "value");
+            }
+            table->create_object_with_primary_key(i * num_transactions + j).set("value", j);
+            table->create_object_with_primary_key(-1).set("value", i);
+            wt.commit();
+        }
+    }
+
+    for (auto& session : sessions)
+        session.wait_for_upload_complete_or_client_stopped();
+    for (auto& session : sessions)
+        session.wait_for_download_complete_or_client_stopped();
+
+    for (int i = 0; i < num_files; ++i) {
+        ReadTransaction rt_1(dbs[2 * i]);
+        ReadTransaction rt_2(dbs[2 * i + 1]);
+        CHECK(compare_groups(rt_1, rt_2, *test_context.logger));
+        CHECK_EQUAL(rt_1.get_table("class_Table")->size(), 2 * num_transactions + 1);
+    }
+}
+
+
+TEST(Sync_DownloadBootstrapCache)
+{
+    // Clients that bootstrap from the same server version are all sent the
+    // same cached DOWNLOAD message. A new cached message is produced once the
+    // file has changed.
+    constexpr int num_rounds = 3;
+    constexpr int num_clients = 3;
+
+    TEST_DIR(dir);
+    TEST_CLIENT_DB(origin);
+    ClientServerFixture::Config config;
+    config.server_enable_download_bootstrap_cache = true;
+    ClientServerFixture fixture(dir, test_context, std::move(config));
+    fixture.start();
+
+    Session origin_session = fixture.make_bound_session(origin, "/test");
+    std::vector<DBTestPathGuard> path_guards;
+    std::vector<DBRef> dbs;
+    std::vector<Session> sessions;
+    for (int round = 0; round < num_rounds; ++round) {
+        {
+            WriteTransaction wt{origin};
+            TableRef table = wt.get_group().get_table("class_Table");
+            if (!table) {
+                table = wt.get_group().add_table_with_primary_key("class_Table", type_Int, "id");
+                table->add_column(type_String, "value");
+            }
+            // Enough data for the DOWNLOAD message body to be compressed
+            for (int i = 0; i < 100; ++i)
+                table->create_object_with_primary_key(round * 100 + i).set("value", std::string(32, char('a' + i % 26)));
+            wt.commit();
+        }
+        origin_session.wait_for_upload_complete_or_client_stopped();
+
+        for (int i = 0; i < num_clients; ++i) {
+            std::string name = std::to_string(round) + "_" + std::to_string(i);
+            std::string path = get_test_path(test_context.get_test_name(), name);
+            path_guards.emplace_back(path);
+            dbs.push_back(DB::create(make_client_replication(), path));
+            sessions.push_back(fixture.make_bound_session(dbs.back(), "/test"));
+        }
+        for (auto& session : sessions)
+            session.wait_for_download_complete_or_client_stopped();
+
+        ReadTransaction rt_1(origin);
+        for (auto& db : dbs) {
+            ReadTransaction rt_2(db);
+            CHECK(compare_groups(rt_1, rt_2, *test_context.logger));
+        }
+    }
+}
+
+
 // This test is a performance study. A single client keeps creating
 // transactions that creates new objects and uploads them. The time to perform
 // upload completion is measured and logged at info level.
@@ -2548,6 +2654,62 @@ TEST_IF(Sync_4GB_Messages, false)
 }
 
 
+TEST(Sync_CompressedHistoryWithDictionary)
+{
+    TEST_DIR(dir);
+    TEST_CLIENT_DB(db_1);
+    TEST_CLIENT_DB(db_2);
+
+    // Many small offline changesets, which is what the compression dictionary
+    // is trained on and meant for.
+    {
+        WriteTransaction wt{db_1};
+        TableRef table = wt.get_group().add_table_with_primary_key("class_Person", type_Int, "id");
+        table->add_column(type_String, "name");
+        table->add_column(type_Int, "age");
+        wt.commit();
+    }
+    for (int i = 0; i < 500; ++i) {
+        WriteTransaction wt{db_1};
+        TableRef table = wt.get_table("class_Person");
+        Obj obj = table->create_object_with_primary_key(i);
+        obj.set("name", "Person " + std::to_string(i % 50));
+        obj.set("age", i % 100);
+        wt.commit();
+    }
+
+    auto changes = get_history(db_1).get_local_changes(db_1->get_version_of_latest_snapshot());
+    CHECK_EQUAL(changes.size(), 501);
+    CHECK_GREATER(changes.back().compression_dictionary.size(), 0);
+    size_t compressed_size = 0;
+    size_t decompressed_size = 0;
+    for (size_t i = 0; i < changes.size(); ++i) {
+        ChunkedBinaryInputStream in{changes[i].changeset};
+        util::AppendBuffer<char> decompressed;
+        CHECK_NOT(util::compression::decompress_nonportable(in, decompressed, changes[i].compression_dictionary));
+        // The dictionary is built from the earlier changesets, and all later
+        // changesets are compressed against it.
+        if (i >= 250) {
+            compressed_size += changes[i].changeset.size();
+            decompressed_size += decompressed.size();
+        }
+    }
+    CHECK_LESS(compressed_size, decompressed_size / 2);
+
+    ClientServerFixture fixture(dir, test_context);
+    fixture.start();
+
+    Session session_1 = fixture.make_bound_session(db_1);
+    session_1.wait_for_upload_complete_or_client_stopped();
+    Session session_2 = fixture.make_bound_session(db_2);
+    session_2.wait_for_download_complete_or_client_stopped();
+
+    ReadTransaction rt_1(db_1);
+    ReadTransaction rt_2(db_2);
+    CHECK(compare_groups(rt_1, rt_2, *test_context.logger));
+}
+
+
 TEST(Sync_RefreshSignedUserToken)
 {
     TEST_DIR(dir);
@@ -4595,6 +4757,75 @@ TEST(Sync_UploadLogCompactionEnabled)
 }
 
 
+TEST(Sync_IncrementalHistoryCompaction)
+{
+    // Every transaction overwrites the same properties many times. The server
+    // compacts at most two history entries per integration, so after
+    // integrating all of them at once, it catches up with the history over the
+    // following uploads.
+    constexpr int num_transactions = 10;
+
+    TEST_DIR(server_dir);
+    TEST_CLIENT_DB(db_1);
+    TEST_CLIENT_DB(db_2);
+
+    ClientServerFixture::Config config;
+    config.history_compaction_window = 2;
+    ClientServerFixture fixture(server_dir, test_context, std::move(config));
+    fixture.start();
+
+    auto write = [&](int i, int num_overwrites) {
+        WriteTransaction wt{db_1};
+        TableRef table = wt.get_group().get_table("class_foo");
+        if (!table) {
+            table = wt.get_group().add_table_with_primary_key("class_foo", type_Int, "id");
+            table->add_column(type_Int, "integer column");
+            table->add_column(type_String, "string column");
+        }
+        Obj obj_1 = table->create_object_with_primary_key(0);
+        Obj obj_2 = table->create_object_with_primary_key(i + 1);
+        for (int j = 0; j < num_overwrites; ++j) {
+            obj_1.set("integer column", i * 100 + j);
+            obj_1.add_int("integer column", 1);
+            obj_2.set("string column", std::string(j % 10 + 1, 'x'));
+        }
+        wt.commit();
+    };
+    auto get_counters = [&] {
+        std::uint_fast64_t num_entries = 0, num_bytes_saved = 0;
+        milliseconds_type time = 0;
+        fixture.get_server().get_history_compaction_counters(num_entries, num_bytes_saved, time);
+        return std::make_pair(num_entries, num_bytes_saved);
+    };
+
+    for (int i = 0; i < num_transactions; ++i)
+        write(i, 100);
+    Session session_1 = fixture.make_bound_session(db_1, "/test");
+    session_1.wait_for_upload_complete_or_client_stopped();
+    CHECK_EQUAL(get_counters().first, 2);
+
+    for (int i = num_transactions; i < 2 * num_transactions; ++i) {
+        write(i, 1);
+        session_1.wait_for_upload_complete_or_client_stopped();
+    }
+    auto [num_entries, num_bytes_saved] = get_counters();
+    CHECK_EQUAL(num_entries, 2 * num_transactions);
+    CHECK_GREATER(num_bytes_saved, num_transactions * 1000);
+
+    Session session_2 = fixture.make_bound_session(db_2, "/test");
+    session_2.wait_for_download_complete_or_client_stopped();
+
+    ReadTransaction rt_1(db_1);
+    ReadTransaction rt_2(db_2);
+    CHECK(compare_groups(rt_1, rt_2, *test_context.logger));
+    ConstTableRef table = rt_2.get_table("class_foo");
+    CHECK_EQUAL(2 * num_transactions + 1, table->size());
+    CHECK_EQUAL((2 * num_transactions - 1) * 100 + 1,
+                table->get_object_with_primary_key(0).get<Int>("integer column"));
+    CHECK_EQUAL("xxxxxxxxxx", table->get_object_with_primary_key(1).get<String>("string column"));
+}
+
+
 TEST(Sync_UploadLogCompactionDisabled)
 {
     TEST_DIR(server_dir);
@@ -7459,6 +7690,254 @@ TEST(Sync_NonIncreasingServerVersions)
                                         DownloadBatchState::SteadyState, *test_context.logger, transact);
 }
 
+namespace {
+
+// Server changesets each creating 10 objects in `class_foo` with a string
+// property. The strings are `string_size_step` times longer for each object.
+struct StringObjectChangesets {
+    std::vector<Changeset> changesets;
+    std::vector<ChangesetEncoder::Buffer> encoded;
+    std::vector<RemoteChangeset> remote;
+
+    StringObjectChangesets(size_t num_changesets, size_t string_size_step,
+                           version_type last_integrated_local_version, timestamp_type& timestamp)
+    {
+        for (size_t i = 0; i < num_changesets; ++i) {
+            Changeset& changeset = changesets.emplace_back();
+            changeset.version = 10 + i;
+            changeset.last_integrated_remote_version = last_integrated_local_version;
+            changeset.origin_timestamp = ++timestamp;
+            changeset.origin_file_ident = 1;
+            auto table_name = changeset.intern_string("foo");
+            auto col_name = changeset.intern_string("str_col");
+            for (size_t j = 0; j < 10; ++j) {
+                instr::PrimaryKey pk{changeset.intern_string(util::format("obj %1-%2", i, j))};
+                instr::CreateObject create;
+                create.object = pk;
+                create.table = table_name;
+                changeset.push_back(create);
+                instr::Update update;
+                update.table = table_name;
+                update.object = pk;
+                update.field = col_name;
+                update.value = instr::Payload{changeset.append_string(string_value(i, j, string_size_step))};
+                changeset.push_back(update);
+            }
+        }
+        for (const auto& changeset : changesets) {
+            encoded.emplace_back();
+            encode_changeset(changeset, encoded.back());
+        }
+        for (size_t i = 0; i < changesets.size(); ++i) {
+            const Changeset& changeset = changesets[i];
+            remote.emplace_back(changeset.version, changeset.last_integrated_remote_version,
+                                BinaryData(encoded[i].data(), encoded[i].size()), changeset.origin_timestamp,
+                                changeset.origin_file_ident);
+        }
+    }
+
+    SyncProgress progress() const
+    {
+        SyncProgress progress = {};
+        progress.download.server_version = changesets.back().version;
+        progress.download.last_integrated_client_version = changesets.back().last_integrated_remote_version;
+        progress.latest_server_version.version = changesets.back().version;
+        progress.latest_server_version.salt = 0x7876543217654321;
+        return progress;
+    }
+
+    static std::string string_value(size_t i, size_t j, size_t string_size_step)
+    {
+        return std::string((i * 10 + j) * string_size_step, 'x');
+    }
+
+    // Check that the objects of the first `num_changesets` changesets exist.
+    void check_objects(unit_test::TestContext& test_context, DB& db, size_t num_changesets,
+                       size_t string_size_step) const
+    {
+        auto tr = db.start_read();
+        auto table = tr->get_table("class_foo");
+        CHECK_EQUAL(table->size(), num_changesets * 10);
+        auto col = table->get_column_key("str_col");
+        for (size_t i = 0; i < num_changesets; ++i) {
+            for (size_t j = 0; j < 10; ++j) {
+                auto obj = table->get_object_with_primary_key(Mixed{util::format("obj %1-%2", i, j)});
+                CHECK_EQUAL(obj.get<String>(col), string_value(i, j, string_size_step));
+            }
+        }
+    }
+};
+
+version_type create_foo_table(DB& db)
+{
+    auto tr = db.start_write();
+    tr->add_table_with_primary_key("class_foo", type_String, "_id")->add_column(type_String, "str_col");
+    return tr->commit();
+}
+
+} // unnamed namespace
+
+TEST_TYPES(Sync_BootstrapBatchIntegration, std::true_type, std::false_type)
+{
+    // Bootstrap changesets are applied as they are parsed if there are no local
+    // changes to merge them with, and parsed up front otherwise.
+    constexpr bool has_local_changes = TEST_TYPE::value;
+    TEST_CLIENT_DB(db);
+
+    auto& history = get_history(db);
+    history.set_client_file_ident(SaltedFileIdent{2, 0x1234567812345678}, false);
+    timestamp_type timestamp{1};
+    history.set_local_origin_timestamp_source([&] {
+        return ++timestamp;
+    });
+
+    auto latest_local_version = create_foo_table(*db);
+    version_type last_integrated_local_version = has_local_changes ? latest_local_version - 1 : latest_local_version;
+    StringObjectChangesets server_changesets(10, 1, last_integrated_local_version, timestamp);
+
+    VersionInfo version_info;
+    size_t changesets_integrated = 0;
+    auto transact = db->start_write();
+    history.integrate_server_changesets(server_changesets.progress(), 0, server_changesets.remote, version_info,
+                                        DownloadBatchState::LastInBatch, *test_context.logger, transact,
+                                        [&](const Transaction&, util::Span<Changeset> changesets) {
+                                            changesets_integrated += changesets.size();
+                                            CHECK_EQUAL(changesets.front().version, 10);
+                                            CHECK_EQUAL(changesets.back().version, 19);
+                                        });
+    CHECK_EQUAL(changesets_integrated, 10);
+    server_changesets.check_objects(test_context, *db, 10, 1);
+}
+
+TEST_TYPES(Sync_PipelinedIntegration, std::true_type, std::false_type)
+{
+    // Large download messages are parsed in the background while the
+    // changesets parsed so far are integrated.
+    constexpr bool has_local_changes = TEST_TYPE::value;
+    TEST_CLIENT_DB(db);
+
+    auto& history = get_history(db);
+    history.set_client_file_ident(SaltedFileIdent{2, 0x1234567812345678}, false);
+    timestamp_type timestamp{1};
+    history.set_local_origin_timestamp_source([&] {
+        return ++timestamp;
+    });
+
+    auto latest_local_version = create_foo_table(*db);
+    version_type last_integrated_local_version = has_local_changes ? latest_local_version - 1 : latest_local_version;
+    StringObjectChangesets server_changesets(20, 100, last_integrated_local_version, timestamp);
+
+    VersionInfo version_info;
+    std::vector<version_type> versions_integrated;
+    auto transact = db->start_read();
+    history.integrate_server_changesets(server_changesets.progress(), 0, server_changesets.remote, version_info,
+                                        DownloadBatchState::SteadyState, *test_context.logger, transact,
+                                        [&](const Transaction&, util::Span<Changeset> changesets) {
+                                            for (const Changeset& changeset : changesets)
+                                                versions_integrated.push_back(changeset.version);
+                                        });
+    CHECK_EQUAL(versions_integrated.size(), 20);
+    for (size_t i = 0; i < versions_integrated.size(); ++i)
+        CHECK_EQUAL(versions_integrated[i], 10 + i);
+    server_changesets.check_objects(test_context, *db, 20, 100);
+
+    version_type current_version;
+    SaltedFileIdent file_ident;
+    SyncProgress progress;
+    history.get_status(current_version, file_ident, progress);
+    CHECK_EQUAL(progress.download.server_version, 29);
+}
+
+TEST(Sync_PipelinedIntegrationBadChangeset)
+{
+    TEST_CLIENT_DB(db);
+
+    auto& history = get_history(db);
+    history.set_client_file_ident(SaltedFileIdent{2, 0x1234567812345678}, false);
+    timestamp_type timestamp{1};
+    history.set_local_origin_timestamp_source([&] {
+        return ++timestamp;
+    });
+
+    auto latest_local_version = create_foo_table(*db);
+    StringObjectChangesets server_changesets(20, 100, latest_local_version, timestamp);
+
+    instr::CreateObject bad_instr;
+    bad_instr.object = InternString{1};
+    bad_instr.table = InternString{2};
+    Changeset bad_changeset;
+    bad_changeset.push_back(bad_instr);
+    ChangesetEncoder::Buffer encoded;
+    encode_changeset(bad_changeset, encoded);
+    server_changesets.remote[10].data = BinaryData(encoded.data(), encoded.size());
+
+    VersionInfo version_info;
+    size_t changesets_integrated = 0;
+    auto transact = db->start_read();
+    CHECK_THROW_EX(history.integrate_server_changesets(
+                       server_changesets.progress(), 0, server_changesets.remote, version_info,
+                       DownloadBatchState::SteadyState, *test_context.logger, transact,
+                       [&](const Transaction&, util::Span<Changeset> changesets) {
+                           changesets_integrated += changesets.size();
+                           CHECK_LESS(changesets.back().version, 20);
+                       }),
+                   sync::IntegrationException,
+                   StringData(e.what()).contains("Failed to parse received changeset: Invalid interned string"));
+
+    // The changesets before the bad one may have been integrated already.
+    CHECK_LESS_EQUAL(changesets_integrated, 10);
+    server_changesets.check_objects(test_context, *db, changesets_integrated, 100);
+}
+
+TEST(Sync_InvalidBootstrapChangesetFromServer)
+{
+    TEST_CLIENT_DB(db);
+
+    auto& history = get_history(db);
+    history.set_client_file_ident(SaltedFileIdent{2, 0x1234567812345678}, false);
+
+    instr::CreateObject bad_instr;
+    bad_instr.object = InternString{1};
+    bad_instr.table = InternString{2};
+
+    Changeset changeset;
+    changeset.push_back(bad_instr);
+
+    ChangesetEncoder::Buffer encoded;
+    encode_changeset(changeset, encoded);
+    RemoteChangeset server_changeset;
+    server_changeset.origin_file_ident = 1;
+    server_changeset.remote_version = 1;
+    server_changeset.data = BinaryData(encoded.data(), encoded.size());
+
+    VersionInfo version_info;
+    auto transact = db->start_write();
+    CHECK_THROW_EX(history.integrate_server_changesets({}, 0, util::Span(&server_changeset, 1), version_info,
+                                                       DownloadBatchState::LastInBatch, *test_context.logger,
+                                                       transact),
+                   sync::IntegrationException,
+                   StringData(e.what()).contains("Failed to parse received changeset: Invalid interned string"));
+    transact->rollback();
+
+    // Changesets which parse but cannot be applied are still reported as such
+    Changeset missing_table_changeset;
+    instr::CreateObject missing_table_instr;
+    missing_table_instr.table = missing_table_changeset.intern_string("missing");
+    missing_table_instr.object = GlobalKey{1, 1};
+    missing_table_changeset.push_back(missing_table_instr);
+    ChangesetEncoder::Buffer missing_table_encoded;
+    encode_changeset(missing_table_changeset, missing_table_encoded);
+    server_changeset.data = BinaryData(missing_table_encoded.data(), missing_table_encoded.size());
+
+    transact = db->start_write();
+    CHECK_THROW_EX(history.integrate_server_changesets({}, 0, util::Span(&server_changeset, 1), version_info,
+                                                       DownloadBatchState::LastInBatch, *test_context.logger,
+                                                       transact),
+                   sync::IntegrationException,
+                   StringData(e.what()).begins_with("Failed to apply received changeset:") &&
+                       StringData(e.what()).contains("Table 'class_missing' does not exist"));
+}
+
 TEST(Sync_DanglingLinksCountInPriorSize)
 {
     SHARED_GROUP_TEST_PATH(path);
@@ -68,7 +68,7 @@ TEST_IF(Sync_HistoryMigration, REALM_MAX_BPNODE_SIZE == 1000)
     // version, and for which corresponding files exist in
     // `resources/history_migration/`. See the `produce_new_files` above for an
     // easy way to generate new files.
-    std::vector<int> client_schema_versions = {11, 12};
+    std::vector<int> client_schema_versions = {11, 12, 13};
     std::vector<int> server_schema_versions = {20};
 
     // Before bootstrapping, there can be no client or server files. After
@@ -0,0 +1,284 @@
+#include "test.hpp"
+#include "peer.hpp"
+
+#include <realm/chunked_binary.hpp>
+#include <realm/sync/changeset_encoder.hpp>
+#include <realm/sync/changeset_parser.hpp>
+#include <realm/sync/transform.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace realm;
+using namespace realm::sync;
+using namespace realm::test_util;
+
+// The tests in this file check that merging independent conflict groups
+// concurrently produces exactly the same changesets as the serial merge, down
+// to the encoded bytes.
+
+namespace {
+
+class TestTransformer : public Transformer {
+public:
+    using Transformer::Transformer;
+    using Transformer::merge_changesets;
+};
+
+Transformer::Config serial_config()
+{
+    Transformer::Config config;
+    config.max_threads = 1;
+    return config;
+}
+
+Transformer::Config parallel_config(size_t num_threads)
+{
+    Transformer::Config config;
+    config.max_threads = num_threads;
+    config.min_parallel_instructions = 0;
+    return config;
+}
+
+void create_schema(WriteTransaction& tr)
+{
+    TableRef person = tr.get_group().add_table_with_primary_key("class_Person", type_Int, "id");
+    person->add_column(type_String, "name");
+    person->add_column(type_Int, "age");
+    person->add_column_list(type_Int, "scores");
+    person->add_column(*person, "friend");
+}
+
+// Perform random modifications of `num_objects` objects. `link_percent` is the
+// chance that a modification links two objects, thereby joining their conflict
+// groups.
+void make_random_changes(Peer& peer, Random& random, size_t num_transactions, int64_t num_objects,
+                         int link_percent)
+{
+    for (size_t i = 0; i < num_transactions; ++i) {
+        peer.history.advance_time(random.draw_int(1, 3));
+        peer.transaction([&](Peer& p) {
+            TableRef table = p.table("class_Person");
+            for (int j = 0; j < 4; ++j) {
+                Obj obj = table->create_object_with_primary_key(random.draw_int<int64_t>(0, num_objects - 1));
+                auto scores = obj.get_list<Int>("scores");
+                if (random.draw_int_mod(100) < link_percent) {
+                    Obj target = table->create_object_with_primary_key(random.draw_int<int64_t>(0, num_objects - 1));
+                    obj.set("friend", target.get_key());
+                    continue;
+                }
+                switch (random.draw_int_mod(7)) {
+                    case 0:
+                        obj.set("age", random.draw_int<int64_t>(0, 100));
+                        break;
+                    case 1:
+                        obj.add_int("age", 1);
+                        break;
+                    case 2:
+                        obj.set("name", std::string(size_t(random.draw_int(1, 8)), char('a' + j)));
+                        break;
+                    case 3:
+                    case 4:
+                        scores.insert(random.draw_int_max(scores.size()), random.draw_int<int64_t>(0, 100));
+                        break;
+                    case 5:
+                        if (scores.size() > 0)
+                            scores.remove(random.draw_int_max(scores.size() - 1));
+                        break;
+                    case 6:
+                        if (random.chance(1, 4))
+                            obj.remove();
+                        else
+                            scores.clear();
+                        break;
+                }
+            }
+        });
+    }
+}
+
+std::vector<Changeset> get_changesets(Peer& peer, version_type begin_version)
+{
+    std::vector<Changeset> changesets;
+    for (version_type version = begin_version + 1; version <= peer.current_version; ++version) {
+        HistoryEntry entry;
+        peer.history.get_history_entry(version, entry);
+        ChunkedBinaryInputStream stream{entry.changeset};
+        Changeset& changeset = changesets.emplace_back();
+        parse_changeset(stream, changeset);
+        changeset.version = version;
+        changeset.transform_sequence = changesets.size() - 1;
+        changeset.origin_timestamp = entry.origin_timestamp;
+        changeset.origin_file_ident = peer.local_file_ident;
+    }
+    return changesets;
+}
+
+std::string encode(const Changeset& changeset)
+{
+    ChangesetEncoder::Buffer buffer;
+    encode_changeset(changeset, buffer);
+    return std::string(buffer.data(), buffer.size());
+}
+
+struct MergeResult {
+    std::vector<Changeset> ours;
+    std::vector<Changeset> theirs;
+    std::string log;
+};
+
+MergeResult merge(Transformer::Config config, std::vector<Changeset> ours, std::vector<Changeset> theirs)
+{
+    MergeResult result{std::move(ours), std::move(theirs), {}};
+    std::vector<Changeset*> our_pointers;
+    for (auto& changeset : result.ours)
+        our_pointers.push_back(&changeset);
+
+    std::ostringstream out;
+    util::StreamLogger logger{out};
+    logger.set_level_threshold(util::Logger::Level::debug);
+    TestTransformer transformer{config};
+    transformer.merge_changesets(1, result.theirs, our_pointers, logger);
+    result.log = out.str();
+    return result;
+}
+
+bool merged_in_parallel(const MergeResult& result)
+{
+    return result.log.find("conflict group(s) on") != std::string::npos;
+}
+
+void check_identical(unit_test::TestContext& test_context, const MergeResult& serial, const MergeResult& parallel)
+{
+    CHECK_EQUAL(serial.ours.size(), parallel.ours.size());
+    CHECK_EQUAL(serial.theirs.size(), parallel.theirs.size());
+    for (size_t i = 0; i < serial.ours.size(); ++i) {
+        CHECK(serial.ours[i] == parallel.ours[i]);
+        CHECK_EQUAL(serial.ours[i].is_dirty(), parallel.ours[i].is_dirty());
+        CHECK_EQUAL(encode(serial.ours[i]), encode(parallel.ours[i]));
+    }
+    for (size_t i = 0; i < serial.theirs.size(); ++i) {
+        CHECK(serial.theirs[i] == parallel.theirs[i]);
+        CHECK_EQUAL(serial.theirs[i].is_dirty(), parallel.theirs[i].is_dirty());
+        CHECK_EQUAL(encode(serial.theirs[i]), encode(parallel.theirs[i]));
+    }
+}
+
+struct ConflictingChanges {
+    std::vector<Changeset> ours;
+    std::vector<Changeset> theirs;
+};
+
+ConflictingChanges make_conflicting_changes(unit_test::TestContext& test_context, Random& random,
+                                            size_t num_transactions, int64_t num_objects, int link_percent)
+{
+    auto client_1 = Peer::create_client(test_context, 2, nullptr);
+    auto client_2 = Peer::create_client(test_context, 3, nullptr);
+    client_1->create_schema(create_schema);
+    client_2->create_schema(create_schema);
+    version_type base_1 = client_1->current_version;
+    version_type base_2 = client_2->current_version;
+    client_2->history.set_time(random.draw_int(0, 2));
+
+    make_random_changes(*client_1, random, num_transactions, num_objects, link_percent);
+    make_random_changes(*client_2, random, num_transactions, num_objects, link_percent);
+    return {get_changesets(*client_1, base_1), get_changesets(*client_2, base_2)};
+}
+
+} // unnamed namespace
+
+
+TEST(Transform_Parallel_MatchesSerial)
+{
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+    for (int round = 0; round < 5; ++round) {
+        auto changes = make_conflicting_changes(test_context, random, 50, 40, 0);
+        auto serial = merge(serial_config(), changes.ours, changes.theirs);
+        CHECK_NOT(merged_in_parallel(serial));
+        CHECK(std::any_of(serial.ours.begin(), serial.ours.end(), [](const Changeset& changeset) {
+            return changeset.is_dirty();
+        }));
+        for (size_t num_threads : {2, 3, 8}) {
+            auto parallel = merge(parallel_config(num_threads), changes.ours, changes.theirs);
+            CHECK(merged_in_parallel(parallel));
+            check_identical(test_context, serial, parallel);
+        }
+    }
+}
+
+
+TEST(Transform_Parallel_LinkedObjects)
+{
+    // Links join conflict groups, so fewer and larger groups are distributed
+    // over the threads.
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+    for (int link_percent : {5, 25, 75}) {
+        auto changes = make_conflicting_changes(test_context, random, 40, 30, link_percent);
+        auto serial = merge(serial_config(), changes.ours, changes.theirs);
+        auto parallel = merge(parallel_config(4), changes.ours, changes.theirs);
+        check_identical(test_context, serial, parallel);
+    }
+}
+
+
+TEST(Transform_Parallel_IsRepeatable)
+{
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+    auto changes = make_conflicting_changes(test_context, random, 50, 40, 10);
+    auto first = merge(parallel_config(4), changes.ours, changes.theirs);
+    for (int i = 0; i < 10; ++i) {
+        auto again = merge(parallel_config(4), changes.ours, changes.theirs);
+        check_identical(test_context, first, again);
+    }
+}
+
+
+TEST(Transform_Parallel_SchemaChangeFallsBackToSerial)
+{
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+    auto changes = make_conflicting_changes(test_context, random, 20, 20, 0);
+
+    // A schema change conflicts with everything, so the merge cannot be split.
+    Changeset& ours = changes.ours.back();
+    Instruction::AddColumn add_column;
+    add_column.table = ours.intern_string("Person");
+    add_column.field = ours.intern_string("nickname");
+    add_column.type = Instruction::Payload::Type::String;
+    add_column.key_type = Instruction::Payload::Type::Null;
+    add_column.nullable = true;
+    add_column.collection_type = Instruction::CollectionType::Single;
+    ours.push_back(add_column);
+
+    auto serial = merge(serial_config(), changes.ours, changes.theirs);
+    auto parallel = merge(parallel_config(4), changes.ours, changes.theirs);
+    CHECK_NOT(merged_in_parallel(parallel));
+    check_identical(test_context, serial, parallel);
+}
+
+
+TEST(Transform_Parallel_BelowThresholdIsSerial)
+{
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+    auto changes = make_conflicting_changes(test_context, random, 10, 20, 0);
+    Transformer::Config config = parallel_config(4);
+    config.min_parallel_instructions = 1000000;
+    auto serial = merge(serial_config(), changes.ours, changes.theirs);
+    auto result = merge(config, changes.ours, changes.theirs);
+    CHECK_NOT(merged_in_parallel(result));
+    check_identical(test_context, serial, result);
+}
+
+
+TEST(Transform_Parallel_DisabledByDefault)
+{
+    Random random(random_int<unsigned long>()); // Seed from slow global generator
+    auto changes = make_conflicting_changes(test_context, random, 50, 40, 0);
+    Transformer::Config config;
+    config.min_parallel_instructions = 0;
+    auto serial = merge(serial_config(), changes.ours, changes.theirs);
+    auto result = merge(config, changes.ours, changes.theirs);
+    CHECK_NOT(merged_in_parallel(result));
+    check_identical(test_context, serial, result);
+}
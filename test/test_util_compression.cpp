@@ -3,6 +3,7 @@
 
 #include <realm/util/buffer.hpp>
 #include <realm/util/compression.hpp>
+#include <realm/util/to_string.hpp>
 
 #include <algorithm>
 #include <cstring>
@@ -381,6 +382,67 @@ TEST(Compression_AllocateAndCompressWithHeader_Noncompressible)
     }
 }
 
+TEST(Compression_AllocateAndCompressWithHeader_Dictionary)
+{
+    // Small inputs which share content with the dictionary are compressed
+    // even though they would be stored uncompressed without one
+    std::string dictionary;
+    for (int i = 0; i < 50; ++i)
+        dictionary += util::format("{\"name\": \"Person %1\", \"email\": \"person%1@example.com\"}", i);
+    std::string uncompressed = "{\"name\": \"Person 123\", \"email\": \"person123@example.com\"}";
+    util::AppendBuffer<char> decompressed;
+
+    auto uncompressed_without_dictionary = compression::allocate_and_compress_nonportable(uncompressed);
+    CHECK_EQUAL(uncompressed_without_dictionary.size(), uncompressed.size() + 2);
+
+    auto compressed = compression::allocate_and_compress_nonportable(uncompressed, dictionary);
+    CHECK_LESS(compressed.size(), uncompressed.size() / 2);
+    {
+        util::SimpleInputStream compressed_stream(compressed);
+        auto ec = compression::decompress_nonportable(compressed_stream, decompressed, dictionary);
+        CHECK_NOT(ec);
+        compare(test_context, uncompressed, decompressed);
+    }
+    {
+        util::SimpleInputStream compressed_stream(compressed);
+        CHECK_EQUAL(compression::get_uncompressed_size_from_header(compressed_stream), uncompressed.size());
+    }
+    {
+        // The dictionary is required
+        util::SimpleInputStream compressed_stream(compressed);
+        auto ec = compression::decompress_nonportable(compressed_stream, decompressed);
+        CHECK_EQUAL(ec, compression::error::decompress_unsupported);
+    }
+    {
+        // and it must be the right one
+        std::string wrong_dictionary(dictionary.size(), 'x');
+        util::SimpleInputStream compressed_stream(compressed);
+        auto ec = compression::decompress_nonportable(compressed_stream, decompressed, wrong_dictionary);
+        CHECK(ec);
+    }
+
+    // Very short data is still stored uncompressed
+    std::string tiny = "{}";
+    compressed = compression::allocate_and_compress_nonportable(tiny, dictionary);
+    CHECK_EQUAL(compressed.size(), tiny.size() + 2);
+
+    // Data too large to benefit from the dictionary is compressed without it
+    auto large = generate_compressible_data((1 << 16) + 10);
+    compressed = compression::allocate_and_compress_nonportable(large, dictionary);
+    CHECK_LESS(compressed.size(), large.size());
+    {
+        util::SimpleInputStream compressed_stream(compressed);
+        auto ec = compression::decompress_nonportable(compressed_stream, decompressed);
+        CHECK_NOT(ec);
+        compare(test_context, large, decompressed);
+    }
+
+    // Incompressible data is stored uncompressed
+    auto random = generate_non_compressible_data(1000);
+    compressed = compression::allocate_and_compress_nonportable(random, dictionary);
+    CHECK_EQUAL(compressed.size(), random.size() + 3);
+}
+
 static void set_invalid_compression_algorithm(Span<char> buffer)
 {
     // Set the algorithm part of the header to 255
@@ -427,13 +489,13 @@ static void copy_stream(Span<char> dest, InputStream& stream)
 }
 
 static void test_decompress_stream(test_util::unit_test::TestContext& test_context, Span<const char> uncompressed,
-                                   Span<const char> compressed)
+                                   Span<const char> compressed, Span<const char> dictionary = {})
 {
     Buffer<char> decompressed(uncompressed.size());
 
     for_each_fib_block_size(uncompressed.size(), compressed, [&](InputStream& stream) {
         size_t total_size = 0;
-        auto decompress_stream = compression::decompress_nonportable_input_stream(stream, total_size);
+        auto decompress_stream = compression::decompress_nonportable_input_stream(stream, total_size, dictionary);
         CHECK_EQUAL(total_size, uncompressed.size());
         if (CHECK(decompress_stream)) {
             copy_stream(decompressed, *decompress_stream);
@@ -476,6 +538,16 @@ TEST(Compression_DecompressInputStream_Compressible_Small)
     test_decompress_stream(test_context, uncompressed, compressed);
 }
 
+TEST(Compression_DecompressInputStream_Dictionary)
+{
+    auto dictionary = generate_compressible_data(1000);
+    size_t uncompressed_size = 10000;
+    auto uncompressed = generate_compressible_data(uncompressed_size);
+    auto compressed = compression::allocate_and_compress_nonportable(uncompressed, dictionary);
+    test_decompress_stream(test_context, uncompressed, compressed, dictionary);
+    test_failed_compress_stream(test_context, compressed);
+}
+
 TEST_IF(Compression_DecompressInputStream_Compressible_Large, false)
 {
     uint64_t uncompressed_size = (uint64_t(1) << 32) + 100;
@@ -405,6 +405,40 @@ TEST(WebSocket_Messages)
     }
 }
 
+TEST(WebSocket_TwoPartMessages)
+{
+    Fixture fixt{test_context.logger};
+    WSConfig& config_1 = fixt.config_1;
+    WSConfig& config_2 = fixt.config_2;
+
+    websocket::Socket& socket_1 = fixt.socket_1;
+    websocket::Socket& socket_2 = fixt.socket_2;
+
+    socket_1.initiate_client_handshake("/uri", "host", "protocol");
+    socket_2.initiate_server_handshake();
+
+    // The client masks the payload, the server writes the second part
+    // directly from the specified buffer.
+    int num_completed = 0;
+    auto handler = [&](std::error_code ec, size_t) {
+        CHECK_NOT(ec);
+        ++num_completed;
+    };
+    socket_1.async_write_binary("head", 4, "body", 4, handler);
+    CHECK_EQUAL(num_completed, 1);
+    CHECK_EQUAL(config_2.binary_messages.size(), 1);
+    CHECK_EQUAL(config_2.binary_messages[0], "headbody");
+
+    std::vector<size_t> body_sizes{0, 1, 121, 122, 65000, 65532, 100000};
+    for (size_t i = 0; i < body_sizes.size(); ++i) {
+        std::string body(body_sizes[i], 'b');
+        socket_2.async_write_binary("head", 4, body.data(), body.size(), handler);
+        CHECK_EQUAL(num_completed, i + 2);
+        CHECK_EQUAL(config_1.binary_messages.size(), i + 1);
+        CHECK_EQUAL(config_1.binary_messages[i], "head" + body);
+    }
+}
+
 TEST(WebSocket_Fragmented_Messages)
 {
     Fixture fixt{test_context.logger};